@@ -1,102 +0,0 @@
-﻿// AlphaBeta.cpp
-#include <vector>
-#include <climits>
-
-class AlphaBeta {
-public:
-	// ساختار برا? نما?ش ?ک حرکت
-	struct Move {
-		int score;
-		// سا?ر پارامترها? مربوط به حرکت
-	};
-
-	// در AlphaBeta
-	Entry* entry = tt.probe(zobristKey);
-	if (entry != nullptr && entry->depth >= depth) {
-		return entry->score;
-	}
-
-
-	AlphaBeta() {} // Constructor
-
-	// تابع ارز?اب? وضع?ت باز? (متناسب با باز? شما با?د پ?اده‌ساز? شود)
-	int evaluatePosition() {
-		// منطق ارز?اب?
-		return 0;
-	}int alpha_beta(Board& board, int depth, int alpha, int beta, bool maximizing, bool quiesce) {
-		if (depth == 0) {
-			if (quiesce) return board.evaluate();
-			// ادامه جستجو در حرکات خشن (کیش/گرفتن مهره)  
-			auto captures = board.generate_captures();
-			for (const auto& move : captures) {
-				Board new_board = board;
-				new_board.apply_move(move);
-				int score = -alpha_beta(new_board, 1, -beta, -alpha, !maximizing, true);
-				alpha = std::max(alpha, score);
-				if (alpha >= beta) break;
-			}
-			return alpha;
-		}
-		// ... منطق Alpha-Beta معمولی  
-	}
-
-	// الگور?تم آلفا-بتا
-	int alphaBeta(int depth, int alpha, int beta, bool maximizingPlayer) {
-		if (depth == 0 /* ?ا شرط پا?ان باز? */) {
-			return evaluatePosition();
-		}
-		if (depth > 2 && moveCount > 4) depth--; // کاهش عمق برای حرکات دیررس
-
-		if (maximizingPlayer) {
-			int maxEval = INT_MIN;
-			for (auto& move : generatePossibleMoves()) {
-				// انجام حرکت
-				int eval = alphaBeta(depth - 1, alpha, beta, false);
-				maxEval = std::max(maxEval, eval);
-				alpha = std::max(alpha, eval);
-				// بازگرداندن حرکت
-				if (beta <= alpha)
-					break; // قطع آلفا-بتا
-			}
-			return maxEval;
-		}
-		else {
-			int minEval = INT_MAX;
-			for (auto& move : generatePossibleMoves()) {
-				// انجام حرکت
-				int eval = alphaBeta(depth - 1, alpha, beta, true);
-				minEval = std::min(minEval, eval);
-				beta = std::min(beta, eval);
-				// بازگرداندن حرکت
-				if (beta <= alpha)
-					break; // قطع آلفا-بتا
-			}
-			return minEval;
-		}
-
-	}
-
-	// تول?د حرکات ممکن (با?د متناسب با باز? شما پ?اده‌ساز? شود)
-	std::vector<Move> generatePossibleMoves() {
-		std::vector<Move> moves;
-		// منطق تول?د حرکات
-		return moves;
-	}
-
-	// تابع اصل? برا? در?افت بهتر?ن حرکت
-	Move getBestMove(int depth) {
-		Move bestMove;
-		int bestValue = INT_MIN;
-		for (auto& move : generatePossibleMoves()) {
-			// انجام حرکت
-			int moveValue = alphaBeta(depth, INT_MIN, INT_MAX, false);
-			// بازگرداندن حرکت
-
-			if (moveValue > bestValue) {
-				bestValue = moveValue;
-				bestMove = move;
-			}
-		}
-		return bestMove;
-	}
-};
\ No newline at end of file
@@ -1,4 +1,16 @@
-﻿// در BitboardUtils.cpp
-constexpr Bitboard knightAttacks[64] = {
-	0x0000000000020400, 0x0000000000050800, // ... مقادیر پیش‌محاسبه شده
-};
\ No newline at end of file
+﻿#include "Bitboards.h"
+#include <iostream>
+
+namespace ChessEngine {
+
+	void printBitboard(Bitboard b) {
+		for (int rank = 7; rank >= 0; rank--) {
+			std::cout << rank + 1 << " ";
+			for (int file = 0; file < 8; file++)
+				std::cout << ((b >> (rank * 8 + file)) & 1 ? "X " : ". ");
+			std::cout << "\n";
+		}
+		std::cout << "  a b c d e f g h\n";
+	}
+
+}
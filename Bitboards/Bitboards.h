@@ -1,134 +1,201 @@
-﻿#include <cstdint>
+﻿#pragma once
 #include <array>
-#include <iostream>
+#include <cstdint>
+#include "../src/Core/Types.h"
+#include "Magic.h"
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
 
 namespace ChessEngine {
 
-	using Bitboard = uint64_t;
-
-	class Bitboards {
-	public:
-		enum class Piece { Pawn, Knight, Bishop, Rook, Queen, King, None };
-
-		static uint64_t pawnAttacks(Square sq, Color color);
-		static uint64_t knightAttacks(Square sq);
-		static uint64_t kingAttacks(Square sq);
-		static uint64_t slidingAttacks(Square sq, uint64_t occupied, const std::vector<std::pair<int, int>>& directions);
-
-			// تعریف رنکها و فایلها
-			static constexpr Bitboard Rank1 = 0x00000000000000FF;
-			static constexpr Bitboard FileA = 0x0101010101010101;
-			static constexpr Bitboard FileB = 0x0202020202020202;
-			// ... سایر فایلها و رنکها
-
-			// پیش‌محاسبه حملات اسب
-			static const std::array<Bitboard, 64> KnightAttacks;
-
-			// Magic Bitboards برای فیل
-			static const std::array<Bitboard, 64> bishopMagics;
-			static std::array<std::array<Bitboard, 512>, 64> bishopAttacks;
-
-			struct Position {
-				std::array<Bitboard, 6> white = {};
-				std::array<Bitboard, 6> black = {};
-				Bitboard whiteOccupancy = 0;
-				Bitboard blackOccupancy = 0;
-				Bitboard allOccupancy = 0;
-				bool whiteKingsideCastle = false;
-				bool blackKingsideCastle = false;
-			};
-		void initBishopAttacks() {
-			for (int square = 0; square < 64; ++square) {
-				Bitboard mask = bishopMask(square); // ماسک مربع‌های مؤثر
-				int bitCount = countBits(mask);
-				for (int i = 0; i < (1 << bitCount); ++i) {
-					Bitboard occupancy = generateOccupancy(mask, i);
-					int index = (occupancy * bishopMagics[square]) >> (64 - 9); // 9 بیت برای فیل
-					bishopAttacks[square][index] = calculateBishopAttacks(square, occupancy);
-				}
-			}
-		}
-		// وضعیت مهره‌ها
-		struct Position {
-			std::array<Bitboard, 6> white = {}; // سرباز، اسب، فیل، رخ، وزیر، شاه
-			std::array<Bitboard, 6> black = {};
-			Bitboard whiteOccupancy = 0;
-			Bitboard blackOccupancy = 0;
-			Bitboard allOccupancy = 0;
-		};
-		// مقداردهی حملات اسب
-		const std::array<Bitboard, 64> Bitboards::KnightAttacks = []() {
-			std::array<Bitboard, 64> attacks{};
-			// ... منطق محاسبه حملات
-			return attacks;
-		}();
-		// به‌روزرسانی وضعیت اشغال‌شده
-		static void updateOccupancy(Position& pos) {
-			pos.whiteOccupancy = pos.white[0] | pos.white[1] | pos.white[2] | pos.white[3] | pos.white[4] | pos.white[5];
-			pos.blackOccupancy = pos.black[0] | pos.black[1] | pos.black[2] | pos.black[3] | pos.black[4] | pos.black[5];
-			pos.allOccupancy = pos.whiteOccupancy | pos.blackOccupancy;
+	// ========== تعریف رنک‌ها و فایل‌ها ==========
+	constexpr Bitboard FileA = 0x0101010101010101ULL;
+	constexpr Bitboard FileB = FileA << 1;
+	constexpr Bitboard FileC = FileA << 2;
+	constexpr Bitboard FileD = FileA << 3;
+	constexpr Bitboard FileE = FileA << 4;
+	constexpr Bitboard FileF = FileA << 5;
+	constexpr Bitboard FileG = FileA << 6;
+	constexpr Bitboard FileH = FileA << 7;
+
+	constexpr Bitboard Rank1 = 0x00000000000000FFULL;
+	constexpr Bitboard Rank2 = Rank1 << 8;
+	constexpr Bitboard Rank3 = Rank1 << 16;
+	constexpr Bitboard Rank4 = Rank1 << 24;
+	constexpr Bitboard Rank5 = Rank1 << 32;
+	constexpr Bitboard Rank6 = Rank1 << 40;
+	constexpr Bitboard Rank7 = Rank1 << 48;
+	constexpr Bitboard Rank8 = Rank1 << 56;
+
+	constexpr Bitboard squareBB(Square sq) { return 1ULL << sq; }
+	constexpr Bitboard fileMask(int file) { return FileA << file; }
+	constexpr Bitboard rankMask(int rank) { return Rank1 << (8 * rank); }
+
+	// ========== عملیات بیتی ==========
+	inline int popCount(Bitboard bb) {
+#if defined(_MSC_VER)
+		return static_cast<int>(__popcnt64(bb));
+#else
+		return __builtin_popcountll(bb);
+#endif
+	}
+
+	// اندیس کم‌ارزش‌ترین بیت (bb نباید صفر باشد)
+	inline Square bitScanForward(Bitboard bb) {
+#if defined(_MSC_VER)
+		unsigned long idx;
+		_BitScanForward64(&idx, bb);
+		return static_cast<Square>(idx);
+#else
+		return static_cast<Square>(__builtin_ctzll(bb));
+#endif
+	}
+
+	// اندیس پرارزش‌ترین بیت (bb نباید صفر باشد)
+	inline Square bitScanReverse(Bitboard bb) {
+#if defined(_MSC_VER)
+		unsigned long idx;
+		_BitScanReverse64(&idx, bb);
+		return static_cast<Square>(idx);
+#else
+		return static_cast<Square>(63 ^ __builtin_clzll(bb));
+#endif
+	}
+
+	inline Square popLsb(Bitboard& bb) {
+		Square sq = bitScanForward(bb);
+		bb &= bb - 1;
+		return sq;
+	}
+
+	constexpr bool moreThanOne(Bitboard bb) { return (bb & (bb - 1)) != 0; }
+
+	// ========== جابه‌جایی بدون عبور از لبه‌ی صفحه ==========
+	constexpr Bitboard shiftNorth(Bitboard b) { return b << 8; }
+	constexpr Bitboard shiftSouth(Bitboard b) { return b >> 8; }
+	constexpr Bitboard shiftEast(Bitboard b) { return (b & ~FileH) << 1; }
+	constexpr Bitboard shiftWest(Bitboard b) { return (b & ~FileA) >> 1; }
+	constexpr Bitboard shiftNorthEast(Bitboard b) { return (b & ~FileH) << 9; }
+	constexpr Bitboard shiftNorthWest(Bitboard b) { return (b & ~FileA) << 7; }
+	constexpr Bitboard shiftSouthEast(Bitboard b) { return (b & ~FileH) >> 7; }
+	constexpr Bitboard shiftSouthWest(Bitboard b) { return (b & ~FileA) >> 9; }
+
+	// حملات گروهی پیاده‌ها
+	constexpr Bitboard pawnAttacksBB(Bitboard pawns, Color color) {
+		return color == Color::White
+			? shiftNorthEast(pawns) | shiftNorthWest(pawns)
+			: shiftSouthEast(pawns) | shiftSouthWest(pawns);
+	}
+
+	// ========== جداول پیش‌محاسبه‌شده‌ی مهره‌های جهشی (زمان کامپایل) ==========
+	inline constexpr std::array<Bitboard, 64> KnightAttacks = []() {
+		std::array<Bitboard, 64> attacks{};
+		for (int sq = 0; sq < 64; ++sq) {
+			Bitboard b = 1ULL << sq;
+			attacks[sq] = ((b << 17) & ~FileA) | ((b << 15) & ~FileH)
+				| ((b << 10) & ~(FileA | FileB)) | ((b << 6) & ~(FileG | FileH))
+				| ((b >> 17) & ~FileH) | ((b >> 15) & ~FileA)
+				| ((b >> 10) & ~(FileG | FileH)) | ((b >> 6) & ~(FileA | FileB));
 		}
+		return attacks;
+	}();
 
-		// تولید حرکت برای سرباز سفید
-		static Bitboard generateWhitePawnMoves(const Position& pos, int square) {
-			Bitboard moves = 0;
-			Bitboard pawn = 1ULL << square;
-			// ... منطق تولید حرکت (همانند کد قبلی)
-			return moves;
+	inline constexpr std::array<Bitboard, 64> KingAttacks = []() {
+		std::array<Bitboard, 64> attacks{};
+		for (int sq = 0; sq < 64; ++sq) {
+			Bitboard b = 1ULL << sq;
+			Bitboard row = b | shiftEast(b) | shiftWest(b);
+			attacks[sq] = (row | shiftNorth(row) | shiftSouth(row)) & ~b;
 		}
-		bool canCastleKingside(const Position& pos, bool isWhite) {
-			if (isWhite && !pos.whiteKingsideCastle) return false;
-			Bitboard castlePath = isWhite ? 0x0000000000000060 : 0x6000000000000000; // f1 و g1 برای سفید
-			return !(pos.allOccupancy & castlePath);
+		return attacks;
+	}();
+
+	// [رنگ][خانه]: خانه‌هایی که پیاده‌ی آن رنگ از این خانه حمله می‌کند
+	inline constexpr std::array<std::array<Bitboard, 64>, 2> PawnAttacks = []() {
+		std::array<std::array<Bitboard, 64>, 2> attacks{};
+		for (int sq = 0; sq < 64; ++sq) {
+			attacks[0][sq] = pawnAttacksBB(1ULL << sq, Color::White);
+			attacks[1][sq] = pawnAttacksBB(1ULL << sq, Color::Black);
 		}
-		// اجرای حرکت و به‌روزرسانی Bitboardها
-		static void makeMove(Position& pos, Piece piece, int from, int to, bool isCapture) {
-			Bitboard fromMask = 1ULL << from;
-			Bitboard toMask = 1ULL << to;
-			pos.white[piece] ^= fromMask | toMask;
-			// ... منطق Capture و به‌روزرسانی
-			updateOccupancy(pos);
+		return attacks;
+	}();
+
+	inline Bitboard knightAttacks(Square sq) { return KnightAttacks[sq]; }
+	inline Bitboard kingAttacks(Square sq) { return KingAttacks[sq]; }
+	inline Bitboard pawnAttacks(Square sq, Color color) { return PawnAttacks[static_cast<int>(color)][sq]; }
+
+	// ========== حملات مهره‌های لغزنده ==========
+	// پیمایش پرتو به پرتو؛ نسخه‌ی مرجع کند، فقط برای تست
+	constexpr Bitboard slidingAttacks(PieceType pt, Square sq, Bitboard occupied) {
+		constexpr int rookDirs[4][2] = { {1, 0}, {-1, 0}, {0, 1}, {0, -1} };
+		constexpr int bishopDirs[4][2] = { {1, 1}, {1, -1}, {-1, 1}, {-1, -1} };
+		const auto& dirs = (pt == PieceType::Rook) ? rookDirs : bishopDirs;
+
+		Bitboard attacks = 0;
+		for (const auto& d : dirs) {
+			int f = fileOf(sq) + d[0];
+			int r = rankOf(sq) + d[1];
+			while (f >= 0 && f < 8 && r >= 0 && r < 8) {
+				Bitboard b = 1ULL << (r * 8 + f);
+				attacks |= b;
+				if (occupied & b) break;
+				f += d[0];
+				r += d[1];
+			}
 		}
+		return attacks;
+	}
+
+	// جدول‌های جادویی؛ initMagics() باید پیش از اولین استفاده صدا زده شود
+	inline Bitboard bishopAttacks(Square sq, Bitboard occupied) {
+		return getBishopAttacks(sq, occupied);
+	}
+
+	inline Bitboard rookAttacks(Square sq, Bitboard occupied) {
+		return getRookAttacks(sq, occupied);
+	}
 
-		// نمایش بصری Bitboard (برای دیباگ)
-		static void printBitboard(Bitboard b) {
-			for (int rank = 7; rank >= 0; --rank) {
-				for (int file = 0; file < 8; ++file) {
-					int square = rank * 8 + file;
-					std::cout << ((b >> square) & 1) << " ";
+	inline Bitboard queenAttacks(Square sq, Bitboard occupied) {
+		return bishopAttacks(sq, occupied) | rookAttacks(sq, occupied);
+	}
+
+	// ========== خطوط بین خانه‌ها ==========
+	namespace detail {
+		// between=true: خانه‌های بین a و b (بدون دو سر)
+		// between=false: کل خط گذرنده از a و b (با دو سر)
+		// برای خانه‌های غیرهم‌راستا صفر است
+		constexpr std::array<std::array<Bitboard, 64>, 64> lineTable(bool between) {
+			constexpr int dirs[8][2] = { {1, 0}, {-1, 0}, {0, 1}, {0, -1}, {1, 1}, {1, -1}, {-1, 1}, {-1, -1} };
+			std::array<std::array<Bitboard, 64>, 64> table{};
+			for (int a = 0; a < 64; ++a) {
+				for (const auto& d : dirs) {
+					Bitboard full = 1ULL << a;
+					for (int sign = -1; sign <= 1; sign += 2) {
+						int f = (a & 7) + sign * d[0], r = (a >> 3) + sign * d[1];
+						for (; f >= 0 && f < 8 && r >= 0 && r < 8; f += sign * d[0], r += sign * d[1])
+							full |= 1ULL << (r * 8 + f);
+					}
+
+					Bitboard acc = 0;
+					int f = (a & 7) + d[0], r = (a >> 3) + d[1];
+					for (; f >= 0 && f < 8 && r >= 0 && r < 8; f += d[0], r += d[1]) {
+						table[a][r * 8 + f] = between ? acc : full;
+						acc |= 1ULL << (r * 8 + f);
+					}
 				}
-				std::cout << "\n";
 			}
+			return table;
 		}
-		int evaluatePawnStructure(const Position& pos, bool isWhite) {
-			int score = 0;
-			Bitboard pawns = isWhite ? pos.white[Pawn] : pos.black[Pawn];
-			// محاسبه جریمه سربازهای ایزوله
-			if ((pawns & FileA) && !(pawns & FileB)) score -= 10;
-			// ...
-			return score;
-		}
-		const std::array<Bitboard, 64> Bitboards::KnightAttacks = []() {
-			std::array<Bitboard, 64> attacks{};
-			for (int square = 0; square < 64; ++square) {
-				Bitboard b = 1ULL << square;
-				attacks[square] = ((b << 15) & ~FileH) | ((b << 6) & ~FileG & ~FileH) |
-					((b >> 10) & ~FileG & ~FileH) | ((b >> 17) & ~FileH) |
-					((b << 17) & ~FileA) | ((b << 10) & ~FileA & ~FileB) |
-					((b >> 6)  & ~FileA & ~FileB) | ((b >> 15) & ~FileA);
-			}
-			return attacks;
-		}();
+	}
 
-		constexpr Square bitScanForward(uint64_t bb) {
-			return static_cast<Square>(__builtin_ctzll(bb));
-		}
+	inline constexpr std::array<std::array<Bitboard, 64>, 64> BetweenBB = detail::lineTable(true);
+	inline constexpr std::array<std::array<Bitboard, 64>, 64> LineBB = detail::lineTable(false);
 
-		constexpr int popCount(uint64_t bb) {
-			return __builtin_popcountll(bb));
-		}
-	};
+	constexpr bool aligned(Square a, Square b, Square c) { return (LineBB[a][b] & (1ULL << c)) != 0; }
+
+	// نمایش بصری Bitboard (برای دیباگ)
+	void printBitboard(Bitboard b);
 
 } // namespace ChessEngine
-	// پیش‌محاسبه حملات اسب (مقداردهی خارج از کلاس)
-	
\ No newline at end of file
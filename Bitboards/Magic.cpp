@@ -1,22 +1,17 @@
 ﻿#include "Magic.h"
+#include "AttackTables.h"
 
-Bitboard getBishopAttacks(Square sq, Bitboard occupancy) {
-	Magic& m = bishopMagics[sq];
-	occupancy &= m.mask;           // استفاده از ماسک داخل ساختار
-	occupancy *= m.magic;          // اعمال عدد جادویی
-	occupancy >>= m.shift;         // شیفت بر اساس تعداد بیت‌های لازم
-	return m.attacks[occupancy];   // دسترسی به آرایه حملات
-}
-// آرایه‌های حملات (مقداردهی اولیه در initMagics())
-Bitboard bishopAttackTable[64][512]; // 2^9 = 512 (حداکثر بیت‌ها برای فیل)
+namespace ChessEngine {
 
-void initMagics() {
-	// مثال برای مربع a1 (مقادیر واقعی باید از پیش محاسبه شوند!)
-	bishopMagics[0] = {
-		.magic = 0x123456789ABCDEF0, // عدد جادویی
-		.mask = 0x007E7E7E7E7E00,    // ماسک حرکتی
-		.attacks = bishopAttackTable[0],
-		.shift = 64 - 9             // 9 بیت برای این مربع
-	};
-	// ...
-}
\ No newline at end of file
+	Magic bishopMagics[64];
+	Magic rookMagics[64];
+
+#if defined(CHESS_SLIDERS_PEXT)
+	SliderBackend sliderBackend = SliderBackend::Pext;
+#else
+	SliderBackend sliderBackend = SliderBackend::Magic;
+#endif
+
+	Bitboard sliderAttacks[BISHOP_ATTACK_SIZE + ROOK_ATTACK_SIZE];
+
+} // namespace ChessEngine
@@ -1,17 +1,86 @@
 ﻿#pragma once
 #include <cstdint>
+#include "../src/Core/Types.h"
 
-typedef uint64_t Bitboard;
-typedef int Square;
+// انتخاب پشتیبان اندیس‌گذاری جدول حملات:
+//   CHESS_SLIDERS_PEXT  : فقط PEXT (کامپایل با BMI2)
+//   CHESS_SLIDERS_MAGIC : فقط ضرب جادویی (قابل حمل، مثلاً ARM)
+//   هیچ‌کدام            : روی x86-64 با CPUID در زمان اجرا انتخاب می‌شود
+#if defined(CHESS_SLIDERS_PEXT)
+#include <immintrin.h>
+#elif !defined(CHESS_SLIDERS_MAGIC) && (defined(__x86_64__) || defined(_M_X64))
+#define CHESS_SLIDERS_RUNTIME_PEXT
+#if defined(_MSC_VER)
+#include <immintrin.h>
+#endif
+#endif
 
-struct Magic {
-	uint64_t magic;  // عدد جادویی
-	Bitboard mask;   // ماسک حرکتی (مربوط به مربع خاص)
-	Bitboard* attacks; // آرایه حملات از پیش محاسبه‌شده
-	int shift;       // تعداد بیت‌های مورد نیاز برای شیفت
-};
+namespace ChessEngine {
 
-extern Magic bishopMagics[64];
-extern Magic rookMagics[64];
+	enum class SliderBackend : uint8_t { Magic, Pext };
 
-void initMagics(); // مقداردهی اولیه
\ No newline at end of file
+	// پشتیبانی که initMagics انتخاب کرده است
+	extern SliderBackend sliderBackend;
+
+#if defined(CHESS_SLIDERS_RUNTIME_PEXT)
+	namespace detail {
+		// دستور pext بدون نیاز به -mbmi2؛ فقط وقتی اجرا می‌شود که CPUID پشتیبانی را تأیید کرده باشد
+		inline uint64_t pext(uint64_t src, uint64_t mask) {
+#if defined(_MSC_VER)
+			return _pext_u64(src, mask);
+#else
+			uint64_t result;
+			__asm__("pextq %2, %1, %0" : "=r"(result) : "r"(src), "r"(mask));
+			return result;
+#endif
+		}
+	}
+#endif
+
+	// اطلاعات جادویی یک خانه به روش «fancy»:
+	// جدول حملات همه‌ی خانه‌ها پشت سر هم در یک آرایه‌ی مشترک قرار دارد
+	// و attacks به ابتدای بخش همین خانه اشاره می‌کند.
+	struct Magic {
+		Bitboard mask;     // خانه‌های مسدودکننده‌ی مرتبط (بدون لبه‌ها)
+		uint64_t magic;    // عدد جادویی
+		Bitboard* attacks; // بخش این خانه در جدول مشترک
+		unsigned shift;    // 64 - تعداد بیت‌های ماسک
+#if defined(CHESS_SLIDERS_RUNTIME_PEXT)
+		// تابع اندیس پشتیبان انتخاب‌شده؛ initMagics یک بار تنظیم می‌کند تا
+		// جستجوی حمله‌ها متغیر سراسری sliderBackend را نخواند
+		unsigned (*indexFn)(const Magic& m, Bitboard occupied);
+#endif
+
+		unsigned magicIndex(Bitboard occupied) const {
+			return static_cast<unsigned>(((occupied & mask) * magic) >> shift);
+		}
+
+		unsigned index(Bitboard occupied) const {
+#if defined(CHESS_SLIDERS_PEXT)
+			return static_cast<unsigned>(_pext_u64(occupied, mask));
+#elif defined(CHESS_SLIDERS_RUNTIME_PEXT)
+			return indexFn(*this, occupied);
+#else
+			return magicIndex(occupied);
+#endif
+		}
+	};
+
+	extern Magic bishopMagics[64];
+	extern Magic rookMagics[64];
+
+	// ساخت جدول‌ها (یک بار در شروع برنامه، یا پس از تغییر پشتیبان وقتی جستجو متوقف است)
+	// در حالت خودکار، PEXT فقط وقتی انتخاب می‌شود که allowPext درست باشد و CPU از BMI2 پشتیبانی کند
+	void initMagics(bool allowPext = true);
+
+	inline Bitboard getBishopAttacks(Square sq, Bitboard occupied) {
+		const Magic& m = bishopMagics[sq];
+		return m.attacks[m.index(occupied)];
+	}
+
+	inline Bitboard getRookAttacks(Square sq, Bitboard occupied) {
+		const Magic& m = rookMagics[sq];
+		return m.attacks[m.index(occupied)];
+	}
+
+} // namespace ChessEngine
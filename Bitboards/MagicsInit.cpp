@@ -1,29 +1,158 @@
 ﻿#include "Magic.h"
 #include "AttackTables.h"
+#include "Bitboards.h"
+#include <cassert>
+#include <cstring>
 
-// اعداد جادویی استاندارد برای فیل (مثال برای چند مربع)
-const uint64_t BISHOP_MAGICS[64] = {
-	// مربع a1 (0x89A2B5EDFC6D01E1 از منابع معتبر)
-	0x89A2B5EDFC6D01E1, 0x44C6495483C37C0C, // ...
-};
-
-// ماسک‌های حرکتی برای فیل (از پیش محاسبه شده)
-const Bitboard BISHOP_MASKS[64] = {
-	0x007E7E7E7E7E00, 0x007C7E7C7E7C00, // ...
-};
-
-// ========== مقداردهی ساختارهای جادویی ==========
-void initMagics() {
-	for (int sq = 0; sq < 64; ++sq) {
-		// مقداردهی فیل
-		bishopMagics[sq] = {
-			.magic = BISHOP_MAGICS[sq],
-			.mask = BISHOP_MASKS[sq],
-			.attacks = bishopAttacks[sq],
-			.shift = 64 - 9 // 9 بیت برای فیل
+#if defined(CHESS_SLIDERS_RUNTIME_PEXT) && defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace ChessEngine {
+
+	namespace {
+		// اعداد جادویی فیل؛ به صورت آفلاین جستجو و با همین ماسک‌ها و شیفت‌ها بررسی شده‌اند
+		constexpr uint64_t BISHOP_MAGICS[64] = {
+			0x0C08081028882700ULL, 0x0208088820424040ULL, 0x2188480100202561ULL, 0x0004104610800140ULL,
+			0x9004504100002000ULL, 0x0A010108C0010041ULL, 0x3800491028200000ULL, 0x0000802101202002ULL,
+			0x81020410B0810100ULL, 0x0408082808404040ULL, 0x0106220084008008ULL, 0x0040182841001082ULL,
+			0x158404504000800EULL, 0x0888810108432808ULL, 0x0100020811180808ULL, 0x0801420A02410400ULL,
+			0x1320559102103101ULL, 0x0182002002240102ULL, 0xA910000200260020ULL, 0x0008010628210000ULL,
+			0x8002000402114461ULL, 0x0000204410080800ULL, 0x0400500205100900ULL, 0x2002014880840100ULL,
+			0x01E1100108102148ULL, 0x0410090044115400ULL, 0x4004084010104040ULL, 0x0202002008008220ULL,
+			0x0001001105004020ULL, 0x0001081022080400ULL, 0x2018842000820806ULL, 0x40008E0000210401ULL,
+			0x2314104102082200ULL, 0x0002100500101109ULL, 0x1224040201411200ULL, 0x0202004040040102ULL,
+			0x0040002022020080ULL, 0x2020004081210080ULL, 0x0442020404004401ULL, 0x0408C08A00090104ULL,
+			0x0898A21821004003ULL, 0xB004189210424820ULL, 0x8008131088031000ULL, 0x0009010148010500ULL,
+			0x2100084104000040ULL, 0x110102108200A100ULL, 0x0010120801144060ULL, 0x0002020A24200200ULL,
+			0x0020880808040000ULL, 0x0A8B041201040103ULL, 0x0140120205114002ULL, 0x6282000242021201ULL,
+			0x080080140D0C0122ULL, 0x0181102011810200ULL, 0x0804041032420400ULL, 0x0020842C00414142ULL,
+			0x06498028010C2082ULL, 0x0062202084042010ULL, 0x8100000211008800ULL, 0x6000000000840400ULL,
+			0x0018000008210100ULL, 0x00040011A0010100ULL, 0x0820090210020204ULL, 0x0402482804858200ULL
 		};
 
-		// مقداردهی قلعه (مشابه با مقادیر خاص خود)
-		// rookMagics[sq] = { ... };
+		// اعداد جادویی رخ
+		constexpr uint64_t ROOK_MAGICS[64] = {
+			0x9880004000102080ULL, 0x9040001000200041ULL, 0x1100200010400900ULL, 0x2080080005801000ULL,
+			0x0200041020080200ULL, 0x0200041041084200ULL, 0x0400080081124410ULL, 0x2180042100004080ULL,
+			0x8000800099644000ULL, 0x0802003040820100ULL, 0x0105801001862000ULL, 0x0101002008100100ULL,
+			0x1000800400080080ULL, 0x0804800200040080ULL, 0x2001800200800900ULL, 0x00160004088204C1ULL,
+			0x228000C001402000ULL, 0x8510004000200050ULL, 0x3001848020029000ULL, 0x0280808010000801ULL,
+			0x0109010010040800ULL, 0x8000808004000200ULL, 0x8000040081021028ULL, 0x40040A0009004884ULL,
+			0x80C0004280008035ULL, 0x0010004040002000ULL, 0x1101200500410070ULL, 0x8410100080080080ULL,
+			0x000C080080800400ULL, 0x4012008080040002ULL, 0x4000040101000200ULL, 0x0061010200008044ULL,
+			0x0080804010800020ULL, 0x3000201008400040ULL, 0x4112008012002444ULL, 0x0848000880801000ULL,
+			0x00A8008008800400ULL, 0x200200280A00500CULL, 0x080A221024004801ULL, 0xC400008042000104ULL,
+			0x8000400080028022ULL, 0x0220008040018020ULL, 0x4000200011010040ULL, 0x10060040210A0010ULL,
+			0x40820020904A0004ULL, 0x0030040002008080ULL, 0x0200020801840010ULL, 0x0084C04100820004ULL,
+			0x4802010080C2A600ULL, 0x0000400080201880ULL, 0x2040801000200080ULL, 0x0180200842001200ULL,
+			0x0013510008000500ULL, 0x0182000C00808A80ULL, 0x1000524821302400ULL, 0x3800040108488200ULL,
+			0x104A004810210082ULL, 0x0004210010420082ULL, 0xC424110008200241ULL, 0x90101000A0088501ULL,
+			0x0182000420100802ULL, 0x4822001001080402ULL, 0x05D0080090012204ULL, 0x2008140089042846ULL
+		};
+
+		// پرتوهای خالی هر جهت؛ برای پر کردن سریع جدول
+		// جهت‌های ۰..۳ رو به بالا (بیت‌های بزرگ‌تر) و ۴..۷ رو به پایین هستند
+		Bitboard rays[8][64];
+
+		void initRays() {
+			constexpr int dirs[8][2] = {
+				{1, 0}, {0, 1}, {1, 1}, {-1, 1},    // شرق، شمال، شمال‌شرق، شمال‌غرب
+				{-1, 0}, {0, -1}, {-1, -1}, {1, -1} // غرب، جنوب، جنوب‌غرب، جنوب‌شرق
+			};
+			for (int sq = 0; sq < 64; ++sq) {
+				for (int d = 0; d < 8; ++d) {
+					Bitboard ray = 0;
+					int f = fileOf(Square(sq)) + dirs[d][0], r = rankOf(Square(sq)) + dirs[d][1];
+					for (; f >= 0 && f < 8 && r >= 0 && r < 8; f += dirs[d][0], r += dirs[d][1])
+						ray |= squareBB(makeSquare(f, r));
+					rays[d][sq] = ray;
+				}
+			}
+		}
+
+		// حمله در یک جهت: پرتو تا اولین مسدودکننده (شامل خودش)
+		Bitboard rayAttacks(int dir, Square sq, Bitboard occupied) {
+			Bitboard attacks = rays[dir][sq];
+			Bitboard blockers = attacks & occupied;
+			if (blockers) {
+				Square first = dir < 4 ? bitScanForward(blockers) : bitScanReverse(blockers);
+				attacks ^= rays[dir][first];
+			}
+			return attacks;
+		}
+
+#if defined(CHESS_SLIDERS_RUNTIME_PEXT)
+		bool cpuHasBmi2() {
+#if defined(_MSC_VER)
+			int regs[4];
+			__cpuidex(regs, 7, 0);
+			return (regs[1] & (1 << 8)) != 0; // EBX بیت ۸
+#else
+			return __builtin_cpu_supports("bmi2");
+#endif
+		}
+#endif
+
+#if defined(CHESS_SLIDERS_RUNTIME_PEXT)
+		unsigned pextIndex(const Magic& m, Bitboard occupied) {
+			return static_cast<unsigned>(detail::pext(occupied, m.mask));
+		}
+
+		unsigned magicIndex(const Magic& m, Bitboard occupied) {
+			return m.magicIndex(occupied);
+		}
+#endif
+
+		void initSlider(Magic magics[64], const uint64_t numbers[64], const int dirs[4], Bitboard* table) {
+			for (int s = 0; s < 64; ++s) {
+				const Square sq = static_cast<Square>(s);
+
+				// لبه‌ها روی نتیجه اثری ندارند، مگر لبه‌ای که مهره روی آن ایستاده
+				const Bitboard edges = ((Rank1 | Rank8) & ~rankMask(rankOf(sq)))
+					| ((FileA | FileH) & ~fileMask(fileOf(sq)));
+
+				Magic& m = magics[s];
+				m.mask = (rays[dirs[0]][s] | rays[dirs[1]][s] | rays[dirs[2]][s] | rays[dirs[3]][s]) & ~edges;
+				m.magic = numbers[s];
+				m.shift = 64 - popCount(m.mask);
+				m.attacks = table;
+#if defined(CHESS_SLIDERS_RUNTIME_PEXT)
+				m.indexFn = sliderBackend == SliderBackend::Pext ? pextIndex : magicIndex;
+#endif
+
+				// پیمایش همه‌ی زیرمجموعه‌های ماسک (Carry-Rippler)
+				Bitboard occupied = 0;
+				do {
+					Bitboard attacks = 0;
+					for (int d = 0; d < 4; ++d)
+						attacks |= rayAttacks(dirs[d], sq, occupied);
+					assert(m.attacks[m.index(occupied)] == 0 || m.attacks[m.index(occupied)] == attacks);
+					m.attacks[m.index(occupied)] = attacks;
+					occupied = (occupied - m.mask) & m.mask;
+				} while (occupied);
+
+				table += 1ULL << popCount(m.mask);
+			}
+		}
 	}
-}
+
+	// ========== مقداردهی ساختارهای جادویی ==========
+	void initMagics(bool allowPext) {
+		static constexpr int bishopDirs[4] = { 2, 3, 6, 7 };
+		static constexpr int rookDirs[4] = { 0, 1, 4, 5 };
+
+#if defined(CHESS_SLIDERS_RUNTIME_PEXT)
+		sliderBackend = (allowPext && cpuHasBmi2()) ? SliderBackend::Pext : SliderBackend::Magic;
+#else
+		(void)allowPext;
+#endif
+
+		// ترتیب اندیس‌ها به پشتیبان بستگی دارد، پس جدول از نو پر می‌شود
+		std::memset(sliderAttacks, 0, sizeof(sliderAttacks));
+		initRays();
+		initSlider(bishopMagics, BISHOP_MAGICS, bishopDirs, sliderAttacks);
+		initSlider(rookMagics, ROOK_MAGICS, rookDirs, sliderAttacks + BISHOP_ATTACK_SIZE);
+	}
+
+} // namespace ChessEngine
@@ -1,9 +1,3 @@
-﻿// در فایل MoveGenerator.hpp
-#include "Board.hpp"
-#include "BitboardUtils.hpp"
-#include <vector>
-
-class MoveGenerator {
-public:
-	static std::vector<uint16_t> generateLegalMoves(const Board& board);
-};
\ No newline at end of file
+﻿#pragma once
+// تولیدکننده‌ی حرکت در src/movegen پیاده‌سازی شده است
+#include "../src/movegen/MoveGenerator.h"
@@ -7,6 +7,9 @@ set(TOOLCHAIN_PATH "C:/Program Files (x86)/GNU Tools Arm Embedded/10 2021.10/bin
 set(CMAKE_C_COMPILER "${TOOLCHAIN_PATH}/arm-none-eabi-gcc.exe")
 set(CMAKE_CXX_COMPILER "${TOOLCHAIN_PATH}/arm-none-eabi-g++.exe")
 
+# PEXT روی ARM وجود ندارد
+set(SLIDER_BACKEND MAGIC CACHE STRING "Slider attack backend: AUTO, MAGIC or PEXT")
+
 # تنظیمات کامپایلر
 set(CMAKE_C_FLAGS "-nostartfiles" CACHE STRING "C Flags")
 set(CMAKE_CXX_FLAGS "-nostartfiles -fno-rtti -fno-exceptions" CACHE STRING "C++ Flags")
@@ -1,118 +1,347 @@
 ﻿#include "Evaluator.h"
-#include "Bitboard.h"
+#include <algorithm>
+#include <cstdlib>
 
+namespace ChessEngine {
 
-// ========== ساختار پیاده ==========
-int Evaluator::pawnStructureScore(const ChessBoard& board, Color color) {
-	int score = 0;
-	Bitboard pawns = board.getBitboard(PieceType::Pawn, color);
+	namespace {
+		// ========== ارزش مواد ==========
+		constexpr int MaterialMg[7] = { 0, 100, 320, 330, 500, 900, 0 };
+		constexpr int MaterialEg[7] = { 0, 120, 300, 320, 530, 950, 0 };
 
-	// پیاده‌های ایزوله
-	Bitboard isolated = pawns & ~shiftEast(pawns | shiftWest(pawns));
-	score -= popCount(isolated) * 15;
+		// سهم هر مهره در فاز بازی (مجموع در موقعیت آغازین: ۲۴)
+		constexpr int PhaseWeight[7] = { 0, 0, 1, 1, 2, 4, 0 };
 
-	// پیاده‌های مضاعف
-	for (int file = 0; file < 8; file++) {
-		Bitboard fileMask = Bitboard::fileMask(file);
-		int count = popCount(pawns & fileMask);
-		if (count > 1) score -= (count - 1) * 10;
-	}
+		// جفت فیل
+		constexpr int BishopPairMg = 30, BishopPairEg = 50;
+
+		// ========== جداول موقعیت ==========
+		// از دید سفید و با رنک ۸ در بالا؛ برای سفید با sq ^ 56 اندیس می‌شوند
+		constexpr std::array<std::array<int, 64>, 6> pieceSquareTables = { {
+			{ // پیاده
+				  0,  0,  0,  0,  0,  0,  0,  0,
+				 50, 50, 50, 50, 50, 50, 50, 50,
+				 10, 10, 20, 30, 30, 20, 10, 10,
+				  5,  5, 10, 25, 25, 10,  5,  5,
+				  0,  0,  0, 20, 20,  0,  0,  0,
+				  5, -5,-10,  0,  0,-10, -5,  5,
+				  5, 10, 10,-20,-20, 10, 10,  5,
+				  0,  0,  0,  0,  0,  0,  0,  0 },
+			{ // اسب
+				-50,-40,-30,-30,-30,-30,-40,-50,
+				-40,-20,  0,  0,  0,  0,-20,-40,
+				-30,  0, 10, 15, 15, 10,  0,-30,
+				-30,  5, 15, 20, 20, 15,  5,-30,
+				-30,  0, 15, 20, 20, 15,  0,-30,
+				-30,  5, 10, 15, 15, 10,  5,-30,
+				-40,-20,  0,  5,  5,  0,-20,-40,
+				-50,-40,-30,-30,-30,-30,-40,-50 },
+			{ // فیل
+				-20,-10,-10,-10,-10,-10,-10,-20,
+				-10,  0,  0,  0,  0,  0,  0,-10,
+				-10,  0,  5, 10, 10,  5,  0,-10,
+				-10,  5,  5, 10, 10,  5,  5,-10,
+				-10,  0, 10, 10, 10, 10,  0,-10,
+				-10, 10, 10, 10, 10, 10, 10,-10,
+				-10,  5,  0,  0,  0,  0,  5,-10,
+				-20,-10,-10,-10,-10,-10,-10,-20 },
+			{ // رخ
+				  0,  0,  0,  0,  0,  0,  0,  0,
+				  5, 10, 10, 10, 10, 10, 10,  5,
+				 -5,  0,  0,  0,  0,  0,  0, -5,
+				 -5,  0,  0,  0,  0,  0,  0, -5,
+				 -5,  0,  0,  0,  0,  0,  0, -5,
+				 -5,  0,  0,  0,  0,  0,  0, -5,
+				 -5,  0,  0,  0,  0,  0,  0, -5,
+				  0,  0,  0,  5,  5,  0,  0,  0 },
+			{ // وزیر
+				-20,-10,-10, -5, -5,-10,-10,-20,
+				-10,  0,  0,  0,  0,  0,  0,-10,
+				-10,  0,  5,  5,  5,  5,  0,-10,
+				 -5,  0,  5,  5,  5,  5,  0, -5,
+				  0,  0,  5,  5,  5,  5,  0, -5,
+				-10,  5,  5,  5,  5,  5,  0,-10,
+				-10,  0,  5,  0,  0,  0,  0,-10,
+				-20,-10,-10, -5, -5,-10,-10,-20 },
+			{ // شاه (میان‌بازی)
+				-30,-40,-40,-50,-50,-40,-40,-30,
+				-30,-40,-40,-50,-50,-40,-40,-30,
+				-30,-40,-40,-50,-50,-40,-40,-30,
+				-30,-40,-40,-50,-50,-40,-40,-30,
+				-20,-30,-30,-40,-40,-30,-30,-20,
+				-10,-20,-20,-20,-20,-20,-20,-10,
+				 20, 20,  0,  0,  0,  0, 20, 20,
+				 20, 30, 10,  0,  0, 10, 30, 20 },
+		} };
+
+		// شاه در آخربازی به مرکز می‌آید
+		constexpr std::array<int, 64> kingEndgameTable = {
+			-50,-40,-30,-20,-20,-30,-40,-50,
+			-30,-20,-10,  0,  0,-10,-20,-30,
+			-30,-10, 20, 30, 30, 20,-10,-30,
+			-30,-10, 30, 40, 40, 30,-10,-30,
+			-30,-10, 30, 40, 40, 30,-10,-30,
+			-30,-10, 20, 30, 30, 20,-10,-30,
+			-30,-30,  0,  0,  0,  0,-30,-30,
+			-50,-30,-30,-30,-30,-30,-30,-50
+		};
+
+		// ========== ماسک‌های پیاده ==========
+		// [رنگ][خانه]: خانه‌های جلوی پیاده در ستون خودش و دو ستون مجاور
+		inline constexpr std::array<std::array<Bitboard, 64>, 2> PassedPawnMask = []() {
+			std::array<std::array<Bitboard, 64>, 2> masks{};
+			for (int sq = 0; sq < 64; ++sq) {
+				const int file = sq & 7, rank = sq >> 3;
+				for (int f = std::max(0, file - 1); f <= std::min(7, file + 1); ++f) {
+					for (int r = rank + 1; r < 8; ++r) masks[0][sq] |= 1ULL << (r * 8 + f);
+					for (int r = rank - 1; r >= 0; --r) masks[1][sq] |= 1ULL << (r * 8 + f);
+				}
+			}
+			return masks;
+		}();
+
+		// پاداش پیاده‌ی رد شده بر اساس رنک نسبی
+		constexpr int PassedBonusMg[8] = { 0, 5, 10, 15, 25, 40, 60, 0 };
+		constexpr int PassedBonusEg[8] = { 0, 10, 15, 25, 45, 75, 120, 0 };
+
+		constexpr int IsolatedPenaltyMg = 10, IsolatedPenaltyEg = 15;
+		constexpr int DoubledPenaltyMg = 10, DoubledPenaltyEg = 20;
+
+		// ========== تحرک و حمله به شاه ==========
+		// [نوع مهره]: وزن هر خانه‌ی در دسترس و تعداد خانه‌ی «عادی»
+		constexpr int MobilityMg[7] = { 0, 0, 4, 5, 2, 1, 0 };
+		constexpr int MobilityEg[7] = { 0, 0, 4, 5, 4, 2, 0 };
+		constexpr int MobilityBase[7] = { 0, 0, 4, 6, 7, 13, 0 };
+		constexpr int KingZoneAttackWeight = 8;
+
+		int relativeRank(Color color, Square sq) {
+			return color == Color::White ? rankOf(sq) : 7 - rankOf(sq);
+		}
 
-	return score;
-}
-
-// ========== ایمنی شاه ==========
-int Evaluator::kingSafetyScore(const ChessBoard& board, Color color) {
-	Square kingSq = board.getKingSquare(color);
-	Bitboard enemyAttacks = 0;
-
-	// جمع‌آوری حملات حریف
-	for (PieceType pt : {Pawn, Knight, Bishop, Rook, Queen}) {
-		Bitboard pieces = board.getBitboard(pt, ~color);
-		while (pieces) {
-			Square sq = bitScanForward(pieces);
-			enemyAttacks |= Bitboard::getAttacks(pt, sq, board.getOccupied());
-			pieces &= pieces - 1;
+		// ========== ارزیاب‌های آخربازی ==========
+		int distance(Square a, Square b) {
+			return std::max(std::abs(fileOf(a) - fileOf(b)), std::abs(rankOf(a) - rankOf(b)));
+		}
+
+		// مهره‌ی کافی برای مات در برابر شاه تنها: شاه حریف به لبه و شاه خودی به آن نزدیک می‌شود
+		int evaluateKXK(const Board& board, Color strongSide) {
+			const Square strongKing = board.getKingSquare(strongSide);
+			const Square weakKing = board.getKingSquare(~strongSide);
+
+			int value = 0;
+			for (int pt = static_cast<int>(PieceType::Pawn); pt <= static_cast<int>(PieceType::Queen); ++pt)
+				value += popCount(board.getBitboard(static_cast<PieceType>(pt), strongSide)) * MaterialEg[pt];
+
+			const int edgeFile = std::max(3 - fileOf(weakKing), fileOf(weakKing) - 4);
+			const int edgeRank = std::max(3 - rankOf(weakKing), rankOf(weakKing) - 4);
+			value += 20 * (edgeFile + edgeRank) + 20 * (7 - distance(strongKing, weakKing));
+			return value;
 		}
 	}
 
-	// جریمه برای حملات نزدیک به شاه
-	Bitboard kingZone = Bitboard::kingAttacks(kingSq);
-	return -popCount(enemyAttacks & kingZone) * 20;
-}
-
-// ========== فعالیت مهره‌ها ==========
-int Evaluator::pieceActivity(const ChessBoard& board, Color color) {
-	int activity = 0;
-	Bitboard knights = board.getBitboard(Knight, color);
-	while (knights) {
-		Square sq = bitScanForward(knights);
-		activity += popCount(Bitboard::knightAttacks(sq));
-		knights &= knights - 1;
+	// ========== ارزیابی کلی ==========
+	int Evaluator::evaluate(const Board& board) {
+		const MaterialEntry& material = probeMaterial(board);
+		if (material.endgame) {
+			const int value = material.endgame(board, material.strongSide);
+			return board.getTurn() == material.strongSide ? value : -value;
+		}
+
+		const PawnEntry& pawns = probePawns(board);
+
+		Score score[2];
+		for (Color c : { Color::White, Color::Black }) {
+			Score& s = score[static_cast<int>(c)];
+			pieceSquareScore(board, c, s);
+			pieceActivityScore(board, c, pawns, s);
+		}
+
+		const int mg = score[0].mg - score[1].mg + pawns.mg + material.mg;
+		int eg = score[0].eg - score[1].eg + pawns.eg + material.eg;
+		const int scale = material.scale[eg > 0 ? 0 : 1];
+		if (scale == ScaleDraw)
+			return 0; // طرف جلوتر نمی‌تواند ببرد؛ امتیاز میان‌بازی هم نباید برتری نشان دهد
+		eg = eg * scale / ScaleNormal;
+		const int phase = material.phase;
+		const int value = (mg * phase + eg * (MaxPhase - phase)) / MaxPhase;
+		return board.getTurn() == Color::White ? value : -value;
 	}
-	return activity;
-}
 
+	// ========== مواد ==========
+	const MaterialEntry& Evaluator::probeMaterial(const Board& board) {
+		const uint64_t key = board.getMaterialKey();
+		MaterialEntry* entry = m_materialTable[key];
+		if (entry->key == key)
+			return *entry;
 
-int Evaluator::evaluate(const Board& board, Color color) {
-	int score = 0;
+		*entry = MaterialEntry();
+		entry->key = key;
 
-	// امتیاز مواد
-	score += materialScore(board, color);
+		int count[2][7] = {};
+		int nonPawn[2] = {};
+		int phase = 0;
+		Score score[2];
+		for (Color c : { Color::White, Color::Black }) {
+			const int us = static_cast<int>(c);
+			for (int pt = static_cast<int>(PieceType::Pawn); pt <= static_cast<int>(PieceType::Queen); ++pt) {
+				count[us][pt] = popCount(board.getBitboard(static_cast<PieceType>(pt), c));
+				score[us].mg += count[us][pt] * MaterialMg[pt];
+				score[us].eg += count[us][pt] * MaterialEg[pt];
+				phase += count[us][pt] * PhaseWeight[pt];
+				if (pt != static_cast<int>(PieceType::Pawn))
+					nonPawn[us] += count[us][pt] * PieceValues[pt];
+			}
 
-	// امتیاز موقعیت
-	score += positionalScore(board, color);
+			// عدم توازن
+			if (count[us][static_cast<int>(PieceType::Bishop)] >= 2) {
+				score[us].mg += BishopPairMg;
+				score[us].eg += BishopPairEg;
+			}
+		}
+		entry->mg = static_cast<int16_t>(score[0].mg - score[1].mg);
+		entry->eg = static_cast<int16_t>(score[0].eg - score[1].eg);
 
-	// پویایی مهره‌ها
-	score += mobilityScore(board, color) * 0.5;
+		entry->phase = static_cast<uint8_t>(std::min(phase, MaxPhase));
 
-	// ساختار پیاده
-	score += pawnStructureScore(board, color);
+		for (Color c : { Color::White, Color::Black }) {
+			const int us = static_cast<int>(c), them = us ^ 1;
 
-	// ایمنی شاه
-	score += kingSafetyScore(board, color);
+			// شاه تنها در برابر مهره‌ی کافی برای مات: وزیر، رخ، دو فیل، فیل و اسب یا سه اسب
+			const int knights = count[us][static_cast<int>(PieceType::Knight)];
+			const int bishops = count[us][static_cast<int>(PieceType::Bishop)];
+			const bool canMate = count[us][static_cast<int>(PieceType::Queen)] > 0
+				|| count[us][static_cast<int>(PieceType::Rook)] > 0
+				|| bishops >= 2 || (bishops > 0 && knights > 0) || knights >= 3;
+			if (canMate && nonPawn[them] == 0 && count[them][static_cast<int>(PieceType::Pawn)] == 0) {
+				entry->endgame = evaluateKXK;
+				entry->strongSide = c;
+			}
 
-	return score;
-}
+			// دقیقاً KNK، KNNK یا KNKN: مات اجباری وجود ندارد. اگر حریف پیاده یا مهره‌ی
+			// دیگری دارد، موقعیت ممکن است بردنی باشد و قاعده‌ی عمومی زیر تصمیم می‌گیرد.
+			const int knightValue = PieceValues[static_cast<int>(PieceType::Knight)];
+			const bool noPawns = count[us][static_cast<int>(PieceType::Pawn)] == 0
+				&& count[them][static_cast<int>(PieceType::Pawn)] == 0;
+			const bool onlyKnights = knights > 0 && nonPawn[us] == knights * knightValue;
+			const bool loneKnight = nonPawn[them] == knightValue && count[them][static_cast<int>(PieceType::Knight)] == 1;
+			if (noPawns && onlyKnights && (
+				(knights <= 2 && nonPawn[them] == 0) || (knights == 1 && loneKnight))) {
+				entry->scale[us] = ScaleDraw;
+				continue;
+			}
 
-int Evaluator::materialScore(const Board& board, Color color) {
-	// محاسبه امتیاز مواد با استفاده از جدول مقادیر
-	const std::map<Piece, int> values = {
-		{Piece::Pawn, 100}, {Piece::Knight, 300},
-		{Piece::Bishop, 300}, {Piece::Rook, 500},
-		{Piece::Queen, 900}, {Piece::King, 0}
-	};
+			// بدون پیاده و با برتری حداکثر یک فیل، برد دشوار یا ناممکن است
+			if (count[us][static_cast<int>(PieceType::Pawn)] == 0
+				&& nonPawn[us] - nonPawn[them] <= PieceValues[static_cast<int>(PieceType::Bishop)]) {
+				entry->scale[us] = static_cast<uint8_t>(
+					nonPawn[us] < PieceValues[static_cast<int>(PieceType::Rook)] ? ScaleDraw
+					: nonPawn[them] <= PieceValues[static_cast<int>(PieceType::Bishop)] ? 4 : 14);
+			}
+		}
+		return *entry;
+	}
 
-	int score = 0;
-	for (const auto&[piece, val] : values)
-		score += popCount(board.getPieces(piece, color)) * val;
+	// ========== جدول موقعیت ==========
+	void Evaluator::pieceSquareScore(const Board& board, Color color, Score& score) {
+		const int flip = color == Color::White ? 56 : 0;
+		for (int pt = static_cast<int>(PieceType::Pawn); pt <= static_cast<int>(PieceType::King); ++pt) {
+			Bitboard pieces = board.getBitboard(static_cast<PieceType>(pt), color);
+			while (pieces) {
+				const int sq = popLsb(pieces) ^ flip;
+				const int pst = pieceSquareTables[pt - 1][sq];
+				score.mg += pst;
+				score.eg += pt == static_cast<int>(PieceType::King) ? kingEndgameTable[sq] : pst;
+			}
+		}
+	}
+
+	// ========== ساختار پیاده ==========
+	const PawnEntry& Evaluator::probePawns(const Board& board) {
+		const uint64_t key = board.getPawnKey();
+		PawnEntry* entry = m_pawnTable[key];
+		if (entry->key == key)
+			return *entry;
+
+		entry->key = key;
+		Score score[2];
+		for (Color c : { Color::White, Color::Black })
+			pawnStructureScore(board, c, *entry, score[static_cast<int>(c)]);
+		entry->mg = static_cast<int16_t>(score[0].mg - score[1].mg);
+		entry->eg = static_cast<int16_t>(score[0].eg - score[1].eg);
+		return *entry;
+	}
 
-	return score;
-}
-#include "Evaluator.h"
+	void Evaluator::pawnStructureScore(const Board& board, Color color, PawnEntry& entry, Score& score) {
+		const int us = static_cast<int>(color);
+		const Bitboard pawns = board.getBitboard(PieceType::Pawn, color);
+		const Bitboard enemyPawns = board.getBitboard(PieceType::Pawn, ~color);
 
-int Evaluator::evaluate(const Board& board) {
-	int score = 0;
-	score += materialScore(board) * 100;
-	score += pawnStructureScore(board) * 30;
-	score += mobilityScore(board) * 10;
-	score += kingSafetyScore(board) * 50;
-	return score;
-}
+		entry.attacks[us] = pawnAttacksBB(pawns, color);
+		Bitboard span = entry.attacks[us];
+		if (color == Color::White) { span |= span << 8; span |= span << 16; span |= span << 32; }
+		else { span |= span >> 8; span |= span >> 16; span |= span >> 32; }
+		entry.attackSpan[us] = span;
+		entry.passed[us] = 0;
 
-int Evaluator::pawnStructureScore(const Board& board) {
-	// محاسبه جریمه پیاده‌های ایزوله و مضاعف
-	uint64_t whitePawns = board.pieceBitboards[W_PAWN];
-	int score = 0;
+		// پیاده‌های ایزوله: هیچ پیاده‌ی خودی در ستون‌های مجاور نیست
+		Bitboard files = 0;
+		for (int file = 0; file < 8; file++)
+			if (pawns & fileMask(file)) files |= fileMask(file);
+		const int isolated = popCount(pawns & ~(shiftEast(files) | shiftWest(files)));
+		score.mg -= isolated * IsolatedPenaltyMg;
+		score.eg -= isolated * IsolatedPenaltyEg;
 
-	// ایزوله
-	score -= popcount(whitePawns & ~BitboardUtils::neighborFiles(whitePawns)) * 15;
+		// پیاده‌های مضاعف
+		for (int file = 0; file < 8; file++) {
+			const int count = popCount(pawns & fileMask(file));
+			if (count > 1) {
+				score.mg -= (count - 1) * DoubledPenaltyMg;
+				score.eg -= (count - 1) * DoubledPenaltyEg;
+			}
+		}
+
+		// پیاده‌های رد شده
+		Bitboard b = pawns;
+		while (b) {
+			const Square sq = popLsb(b);
+			if (!(PassedPawnMask[us][sq] & enemyPawns)) {
+				entry.passed[us] |= squareBB(sq);
+				const int r = relativeRank(color, sq);
+				score.mg += PassedBonusMg[r];
+				score.eg += PassedBonusEg[r];
+			}
+		}
+	}
+
+	// ========== تحرک و حمله به خانه‌های اطراف شاه حریف ==========
+	void Evaluator::pieceActivityScore(const Board& board, Color color, const PawnEntry& pawns, Score& score) {
+		const Bitboard occupied = board.getOccupied();
+		const Bitboard available = ~board.getColorPieces(color) & ~pawns.attacks[static_cast<int>(~color)];
+		const Bitboard kingZone = kingAttacks(board.getKingSquare(~color));
+
+		int kingZoneAttacks = 0;
+		for (PieceType pt : { PieceType::Knight, PieceType::Bishop, PieceType::Rook, PieceType::Queen }) {
+			const int i = static_cast<int>(pt);
+			Bitboard pieces = board.getBitboard(pt, color);
+			while (pieces) {
+				const Square sq = popLsb(pieces);
+				Bitboard attacks;
+				switch (pt) {
+				case PieceType::Knight: attacks = knightAttacks(sq); break;
+				case PieceType::Bishop: attacks = bishopAttacks(sq, occupied); break;
+				case PieceType::Rook: attacks = rookAttacks(sq, occupied); break;
+				default: attacks = queenAttacks(sq, occupied); break;
+				}
+
+				const int mobility = popCount(attacks & available) - MobilityBase[i];
+				score.mg += mobility * MobilityMg[i];
+				score.eg += mobility * MobilityEg[i];
+				kingZoneAttacks += popCount(attacks & kingZone);
+			}
+		}
 
-	// مضاعف
-	for (int file = 0; file < 8; file++) {
-		int count = popcount(whitePawns & BitboardUtils::fileMask(file));
-		if (count > 1) score -= (count - 1) * 10;
+		// حمله به شاه فقط در میان‌بازی اهمیت دارد
+		score.mg += kingZoneAttacks * KingZoneAttackWeight;
 	}
 
-	return score;
-}
\ No newline at end of file
+} // namespace ChessEngine
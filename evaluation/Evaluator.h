@@ -1,26 +1,43 @@
+// evaluation/Evaluator.h
 #pragma once
-#include "../Core/Board.h"
+#include "../src/Core/Board.h"
+#include "MaterialHash.h"
+#include "PawnHash.h"
+
 namespace ChessEngine {
 
-	class Evaluator {	
-	private:
-		static constexpr int PieceValues[6] = { 100, 300, 300, 500, 900, 10000 };
-		static int evaluateMaterial(const Board& board);
-		static int evaluatePawnStructure(const Board& board);
-		static int evaluateKingSafety(const Board& board);
+	// ارزیابی ایستا با درون‌یابی میان‌بازی/آخربازی بر اساس فاز بازی
+	// امتیاز به سانتی‌پیاده و از دید طرف نوبت‌دار است (مناسب negamax)
+	// هر ترد جستجو نمونه‌ی خودش را دارد چون جدول‌های پیاده و مواد داخل آن هستند
+	class Evaluator {
 	public:
-		static int evaluate(const Board& board);
+		int evaluate(const Board& board);
+
+		// ارزش مهره‌ها با اندیس PieceType (برای مرتب‌سازی حرکات)
+		static constexpr int PieceValues[7] = { 0, 100, 320, 330, 500, 900, 0 };
 
 	private:
-		// ǘ? ??
-		static int materialScore(const Board& board);
-		static int pawnStructureScore(const Board& board);
-		static int mobilityScore(const Board& board);
-		static int kingSafetyScore(const Board& board);
-		static int positionalScore(const Board& board);
-
-		//   ??
-		static const std::array<std::array<int, 64>, 6> pieceSquareTables;
+		struct Score {
+			int mg = 0;
+			int eg = 0;
+		};
+
+		// ارزیابی‌های جزئی برای یک رنگ
+		static void pieceSquareScore(const Board& board, Color color, Score& score);
+		static void pieceActivityScore(const Board& board, Color color, const PawnEntry& pawns, Score& score);
+
+		// ورودی جدول پیاده برای موقعیت؛ در صورت نبودن، ساختار پیاده ارزیابی و ذخیره می‌شود
+		const PawnEntry& probePawns(const Board& board);
+		static void pawnStructureScore(const Board& board, Color color, PawnEntry& entry, Score& score);
+
+		// ورودی جدول مواد: ارزش مواد، عدم توازن، فاز و ارزیاب/مقیاس آخربازی
+		const MaterialEntry& probeMaterial(const Board& board);
+
+		// ۰ (فقط پیاده و شاه) تا MaxPhase (همه‌ی مهره‌ها)
+		static constexpr int MaxPhase = 24;
+
+		PawnHashTable m_pawnTable;
+		MaterialHashTable m_materialTable;
 	};
 
-} // namespace ChessEngine
\ No newline at end of file
+} // namespace ChessEngine
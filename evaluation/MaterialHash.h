@@ -0,0 +1,44 @@
+// evaluation/MaterialHash.h
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "../src/Core/Types.h"
+
+namespace ChessEngine {
+
+	class Board;
+
+	// ارزیاب اختصاصی آخربازی؛ امتیاز از دید strongSide
+	using EndgameFn = int (*)(const Board& board, Color strongSide);
+
+	// ضریب مقیاس امتیاز آخربازی (از ۶۴)
+	constexpr int ScaleNormal = 64;
+	constexpr int ScaleDraw = 0;
+
+	// هر آنچه فقط به تعداد مهره‌ها بستگی دارد؛ با Board::getMaterialKey() اندیس می‌شود
+	struct MaterialEntry {
+		uint64_t key = 0;
+		int16_t mg = 0; // ارزش مواد و عدم توازن، سفید منهای سیاه
+		int16_t eg = 0;
+		uint8_t phase = 0;                        // ۰ تا MaxPhase برای درون‌یابی
+		uint8_t scale[2] = { ScaleNormal, ScaleNormal }; // [رنگ] وقتی آن رنگ در آخربازی جلوست
+		Color strongSide = Color::White;
+		EndgameFn endgame = nullptr;              // اگر مقدار دارد جایگزین کل ارزیابی می‌شود
+	};
+
+	// جدول با نگاشت مستقیم؛ مانند جدول پیاده برای هر ترد جداست
+	class MaterialHashTable {
+	public:
+		static constexpr size_t Size = 8192; // توان دو؛ حافظه Size * sizeof(MaterialEntry)
+		static_assert(sizeof(MaterialEntry) <= 32, "material table should stay within 256 KB per thread");
+
+		MaterialHashTable() : m_entries(Size) {}
+
+		MaterialEntry* operator[](uint64_t key) { return &m_entries[key & (Size - 1)]; }
+
+	private:
+		std::vector<MaterialEntry> m_entries;
+	};
+
+} // namespace ChessEngine
@@ -0,0 +1,34 @@
+// evaluation/PawnHash.h
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "../src/Core/Types.h"
+
+namespace ChessEngine {
+
+	// هر آنچه فقط به جای پیاده‌ها بستگی دارد؛ با Board::getPawnKey() اندیس می‌شود
+	struct PawnEntry {
+		uint64_t key = 0;
+		int16_t mg = 0; // امتیاز ساختار پیاده، سفید منهای سیاه
+		int16_t eg = 0;
+		Bitboard passed[2] = {};     // [رنگ] پیاده‌های رد شده
+		Bitboard attacks[2] = {};    // [رنگ] خانه‌های زیر حمله‌ی پیاده‌ها
+		Bitboard attackSpan[2] = {}; // [رنگ] خانه‌هایی که پیاده‌ها با پیشروی می‌توانند به آن حمله کنند
+	};
+
+	// جدول با نگاشت مستقیم و جایگزینی همیشگی. هر ترد جستجو Evaluator و در نتیجه
+	// جدول خودش را دارد، پس برخلاف جدول انتقال به هیچ هماهنگی بین تردها نیاز نیست.
+	// کلید پیاده هرگز صفر نیست، پس ورودی خالی با هیچ موقعیتی اشتباه گرفته نمی‌شود.
+	class PawnHashTable {
+	public:
+		static constexpr size_t Size = 16384; // توان دو، حدود ۱ مگابایت
+
+		PawnHashTable() : m_entries(Size) {}
+
+		PawnEntry* operator[](uint64_t key) { return &m_entries[key & (Size - 1)]; }
+
+	private:
+		std::vector<PawnEntry> m_entries;
+	};
+
+} // namespace ChessEngine
@@ -1,611 +1,412 @@
 ﻿#include "Board.h"
-#include "MoveGenerator.h"
+#include "Zobrist.h"
+#include "../movegen/MoveGenerator.h"
+#include <algorithm>
+#include <cassert>
+#include <cctype>
 #include <iostream>
 #include <sstream>
-#include <immintrin.h>  
 
 namespace ChessEngine {
 
-	Board::Board() {
-		setToStartPosition();
-	}
+	namespace {
+		// حقوقی که با حرکت از/به هر خانه از دست می‌روند
+		constexpr std::array<uint8_t, 64> CastlingRightsLost = []() {
+			std::array<uint8_t, 64> lost{};
+			lost[E1] = WhiteKingSide | WhiteQueenSide;
+			lost[H1] = WhiteKingSide;
+			lost[A1] = WhiteQueenSide;
+			lost[E8] = BlackKingSide | BlackQueenSide;
+			lost[H8] = BlackKingSide;
+			lost[A8] = BlackQueenSide;
+			return lost;
+		}();
 
-	void Board::setToStartPosition() {
-		// پاکسازی صفحه
-		m_squares.fill(Piece::None);
-
-		// تنطیم مهره‌های سفید
-		m_squares[0] = Piece::WhiteRook;
-		m_squares[1] = Piece::WhiteKnight;
-		m_squares[2] = Piece::WhiteBishop;
-		m_squares[3] = Piece::WhiteQueen;
-		m_squares[4] = Piece::WhiteKing;
-		m_squares[5] = Piece::WhiteBishop;
-		m_squares[6] = Piece::WhiteKnight;
-		m_squares[7] = Piece::WhiteRook;
-		for (int i = 8; i < 16; i++) m_squares[i] = Piece::WhitePawn;
-
-		// تنطیم مهره‌های سیاه
-		m_squares[56] = Piece::BlackRook;
-		m_squares[57] = Piece::BlackKnight;
-		m_squares[58] = Piece::BlackBishop;
-		m_squares[59] = Piece::BlackQueen;
-		m_squares[60] = Piece::BlackKing;
-		m_squares[61] = Piece::BlackBishop;
-		m_squares[62] = Piece::BlackKnight;
-		m_squares[63] = Piece::BlackRook;
-		for (int i = 48; i < 56; i++) m_squares[i] = Piece::BlackPawn;
-
-		// تنظیمات اولیه
-		m_turn = Color::White;
-		std::fill(m_castlingRights, m_castlingRights + 4, true);
-		m_enPassantSquare = Square::None;
-		m_halfMoveClock = 0;
-		m_fullMoveNumber = 1;
+		constexpr int pawnPush(Color c) { return c == Color::White ? 8 : -8; }
 	}
 
-	std::vector<Move> Board::generateLegalMoves() const {
-		return MoveGenerator::generateLegalMoves(*this);
-	}
-	
-	void Board::makeMove(const Move& move) {
-		// ذخیره تاریخچه برای undo
-		MoveHistory history;
-		history.move = move;
-		history.castlingRights = { m_castlingRights[0], m_castlingRights[1], m_castlingRights[2], m_castlingRights[3] };
-		history.enPassantSquare = m_enPassantSquare;
-		history.halfMoveClock = m_halfMoveClock;
-		m_moveHistory.push_back(history);
-
-		// اعمال حرکت
-		m_squares[move.to] = m_squares[move.from];
-		m_squares[move.from] = Piece::None;
-
-		if (move.type == MoveType::EnPassant) {
-			// حذف پیاده حریف
-		}
-		// پردازش حرکات خاص
-		if (move.type == MoveType::Castling) {
-			// حرکت قلعه
-			// ...
+	Board::Board() {
+		static const bool tablesReady = (initZobrist(), initMagics(), true);
+		(void)tablesReady;
+		setFromFEN(StartFEN);
+	}
+
+	// ========== تغییرات پایه‌ی صفحه ==========
+	void Board::clearBoard() {
+		m_board.fill(Piece::None);
+		m_pieces.fill(0);
+		m_colors.fill(0);
+	}
+
+	void Board::putPiece(Piece pc, Square sq) {
+		m_board[sq] = pc;
+		m_pieces[static_cast<int>(pc)] |= squareBB(sq);
+		m_colors[static_cast<int>(colorOf(pc))] |= squareBB(sq);
+	}
+
+	void Board::removePiece(Square sq) {
+		Piece pc = m_board[sq];
+		m_pieces[static_cast<int>(pc)] ^= squareBB(sq);
+		m_colors[static_cast<int>(colorOf(pc))] ^= squareBB(sq);
+		m_board[sq] = Piece::None;
+	}
+
+	void Board::movePiece(Square from, Square to) {
+		Piece pc = m_board[from];
+		Bitboard fromTo = squareBB(from) | squareBB(to);
+		m_pieces[static_cast<int>(pc)] ^= fromTo;
+		m_colors[static_cast<int>(colorOf(pc))] ^= fromTo;
+		m_board[from] = Piece::None;
+		m_board[to] = pc;
+	}
+
+	void Board::computeKeys(StateInfo& st) const {
+		st.key = 0;
+		st.pawnKey = zobristNoPawns;
+		st.materialKey = 0;
+		for (int sq = A1; sq <= H8; sq++) {
+			const Piece pc = m_board[sq];
+			if (pc == Piece::None)
+				continue;
+			st.key ^= zobristKeys[static_cast<int>(pc)][sq];
+			if (typeOf(pc) == PieceType::Pawn)
+				st.pawnKey ^= zobristKeys[static_cast<int>(pc)][sq];
 		}
-		else if (move.type == MoveType::EnPassant) {
-			// حذف پیاده حریف در En Passant
-			// ...
+		for (int p = 0; p < PIECE_NB; p++)
+			for (int n = std::min(popCount(m_pieces[p]), MaxPieceCount); n > 0; n--)
+				st.materialKey ^= zobristMaterial[p][n - 1];
+
+		if (m_turn == Color::Black)
+			st.key ^= zobristSide;
+		st.key ^= zobristCastling[st.castling];
+		if (st.enPassant != NoSquare)
+			st.key ^= zobristEnPassant[fileOf(st.enPassant)];
+	}
+
+	// ========== اعمال حرکت ==========
+	void Board::makeMove(Move move) {
+		assert(m_stateIdx + 1 < MAX_GAME_PLY);
+
+		const StateInfo& prev = m_states[m_stateIdx];
+		StateInfo& st = m_states[++m_stateIdx];
+		st.key = prev.key ^ zobristSide;
+		st.pawnKey = prev.pawnKey;
+		st.materialKey = prev.materialKey;
+		st.castling = prev.castling;
+		st.halfMoveClock = prev.halfMoveClock + 1;
+		st.pliesFromNull = prev.pliesFromNull + 1;
+		st.captured = Piece::None;
+		st.enPassant = NoSquare;
+		if (prev.enPassant != NoSquare)
+			st.key ^= zobristEnPassant[fileOf(prev.enPassant)];
+
+		const Color us = m_turn;
+		const Color them = ~us;
+		const Square from = move.from();
+		const Square to = move.to();
+		const Piece pc = m_board[from];
+
+		if (move.isCastling()) {
+			// شاه e1g1 / e1c1 حرکت می‌کند؛ رخ متناظر را جابه‌جا کن
+			const bool kingSide = to > from;
+			const Square rookFrom = makeSquare(kingSide ? 7 : 0, rankOf(from));
+			const Square rookTo = makeSquare(kingSide ? 5 : 3, rankOf(from));
+			const int rook = static_cast<int>(m_board[rookFrom]);
+			movePiece(rookFrom, rookTo);
+			st.key ^= zobristKeys[rook][rookFrom] ^ zobristKeys[rook][rookTo];
 		}
-		else if (move.type == MoveType::Promotion) {
-			// ارتقای پیاده
-			m_squares[move.to] = move.promotion;
+		else {
+			const Square capSq = move.isEnPassant() ? static_cast<Square>(to - pawnPush(us)) : to;
+			const Piece captured = m_board[capSq];
+			if (captured != Piece::None) {
+				removePiece(capSq);
+				st.key ^= zobristKeys[static_cast<int>(captured)][capSq];
+				st.materialKey ^= zobristMaterial[static_cast<int>(captured)][popCount(getBitboard(captured))];
+				if (typeOf(captured) == PieceType::Pawn)
+					st.pawnKey ^= zobristKeys[static_cast<int>(captured)][capSq];
+				st.captured = captured;
+				st.halfMoveClock = 0;
+			}
 		}
 
-		// به‌روزرسانی وضعیت
-		m_turn = (m_turn == Color::White) ? Color::Black : Color::White;
-	}
-
-	void Board::undoMove() {
-		if (m_moveHistory.empty()) return;
-
-		const auto& history = m_moveHistory.back();
-		const Move& move = history.move;
+		movePiece(from, to);
+		st.key ^= zobristKeys[static_cast<int>(pc)][from] ^ zobristKeys[static_cast<int>(pc)][to];
 
-		// بازگرداندن حرکت
-		m_squares[move.from] = m_squares[move.to];
-		m_squares[move.to] = Piece::None;
+		if (typeOf(pc) == PieceType::Pawn) {
+			st.halfMoveClock = 0;
+			st.pawnKey ^= zobristKeys[static_cast<int>(pc)][from] ^ zobristKeys[static_cast<int>(pc)][to];
 
-		// بازگردانی وضعیت
-		std::copy(history.castlingRights.begin(), history.castlingRights.end(), m_castlingRights);
-		m_enPassantSquare = history.enPassantSquare;
-		m_halfMoveClock = history.halfMoveClock;
-		m_turn = (m_turn == Color::White) ? Color::Black : Color::White;
-
-		m_moveHistory.pop_back();
-	}
-
-	std::string Board::toFEN() const {
-		std::stringstream fen;
-		int empty = 0;
-
-		// موقعیت مهره‌ها
-		for (int rank = 7; rank >= 0; rank--) {
-			for (int file = 0; file < 8; file++) {
-				int sq = rank * 8 + file;
-				Piece piece = m_squares[sq];
-				if (piece == Piece::None) {
-					empty++;
-				}
-				else {
-					if (empty > 0) fen << empty;
-					empty = 0;
-					fen << pieceToChar(piece);
+			if ((from ^ to) == 16) {
+				// خانه‌ی آنپاسان فقط وقتی ثبت می‌شود که پیاده‌ی حریف واقعاً بتواند بگیرد
+				const Square ep = static_cast<Square>((from + to) / 2);
+				if (pawnAttacks(ep, us) & getBitboard(PieceType::Pawn, them)) {
+					st.enPassant = ep;
+					st.key ^= zobristEnPassant[fileOf(ep)];
 				}
 			}
-			if (empty > 0) fen << empty;
-			if (rank > 0) fen << '/';
-			empty = 0;
-		}
-
-		// رنگ نوبت
-		fen << (m_turn == Color::White ? " w " : " b ");
-
-		// حقوق قلعه
-		bool anyCastling = false;
-		if (m_castlingRights[0]) { fen << 'K'; anyCastling = true; }
-		if (m_castlingRights[1]) { fen << 'Q'; anyCastling = true; }
-		if (m_castlingRights[2]) { fen << 'k'; anyCastling = true; }
-		if (m_castlingRights[3]) { fen << 'q'; anyCastling = true; }
-		if (!anyCastling) fen << '-';
-
-		// En Passant
-		fen << (m_enPassantSquare == Square::None ? " - " : " " + squareToString(m_enPassantSquare) + " ");
-
-		// ساعت حرکت
-		fen << m_halfMoveClock << " " << m_fullMoveNumber;
-
-		return fen.str();
-	}
-
-	void Board::print() const {
-		const std::string pieces = " PNBRQK  pnbrqk";
-		for (int rank = 7; rank >= 0; rank--) {
-			std::cout << rank + 1 << " ";
-			for (int file = 0; file < 8; file++) {
-				int sq = rank * 8 + file;
-				std::cout << pieces[static_cast<int>(m_squares[sq])] << " ";
+			else if (move.isPromotion()) {
+				const Piece promoted = makePiece(us, move.promotion());
+				removePiece(to);
+				putPiece(promoted, to);
+				st.key ^= zobristKeys[static_cast<int>(pc)][to] ^ zobristKeys[static_cast<int>(promoted)][to];
+				st.pawnKey ^= zobristKeys[static_cast<int>(pc)][to];
+				st.materialKey ^= zobristMaterial[static_cast<int>(pc)][popCount(getBitboard(pc))]
+					^ zobristMaterial[static_cast<int>(promoted)][popCount(getBitboard(promoted)) - 1];
 			}
-			std::cout << "\n";
 		}
-		std::cout << "  a b c d e f g h\n";
-	}
 
-	// توابع کمکی
-	Bitboard Board::getPawnAttacks(Square sq, Color color) const {
-		// محاسبه حمله‌های پیاده با Bitboard
-		// ...
-	}
+		const uint8_t lost = CastlingRightsLost[from] | CastlingRightsLost[to];
+		if (st.castling & lost) {
+			st.key ^= zobristCastling[st.castling];
+			st.castling &= ~lost;
+			st.key ^= zobristCastling[st.castling];
+		}
 
-	Bitboard Board::getKnightAttacks(Square sq) const {
-		// جدول از پیش محاسبه شده برای حرکت اسب
-		static const Bitboard knightAttacks[64] = {/*...*/ };
-		return knightAttacks[sq];
+		m_turn = them;
+		m_gamePly++;
 	}
 
-	bool Board::isSquareAttacked(Square sq, Color attackerColor) const {
-		// بررسی حمله توسط تمام مهره‌های حریف
-		// ...
-	}
-	
+	// ========== بازگرداندن حرکت ==========
+	void Board::unmakeMove(Move move) {
+		m_turn = ~m_turn;
+		m_gamePly--;
 
-// تکمیل پارسر FEN
-	void Board::ResetToFEN(const std::string& fen) {
-		// مثال FEN: "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1"
-		std::istringstream iss(fen);
-		std::string piecePlacement, activeColor, castling, enPassant, halfMove, fullMove;
+		const Color us = m_turn;
+		const Square from = move.from();
+		const Square to = move.to();
+		const StateInfo& st = m_states[m_stateIdx];
 
-		iss >> piecePlacement >> activeColor >> castling >> enPassant >> halfMove >> fullMove;
-
-		// ریست تخته
-		memset(bitboards, 0, sizeof(bitboards));
-
-		int row = 7, col = 0;
-		for (char c : piecePlacement) {
-			if (c == '/') {
-				row--;
-				col = 0;
-			}
-			else if (isdigit(c)) {
-				col += c - '0';
-			}
-			else {
-				int piece = CharToPiece(c);
-				SetBit(bitboards[piece], row * 8 + col);
-				col++;
-			}
+		if (move.isPromotion()) {
+			removePiece(to);
+			putPiece(makePiece(us, PieceType::Pawn), to);
 		}
 
-		isWhiteTurn = (activeColor == "w");
-		// مدیریت وضعیت قلعه و آنپاسان (نیاز به پیاده‌سازی)
-	}
-	// MoveGenerator.cpp
-	std::vector<Move> Board::GenerateKnightMoves(int square, Color color) {
-		std::vector<Move> moves;
-		uint64_t knightAttacks = precomputedKnightAttacks[square];
-		uint64_t targetSquares = knightAttacks & ~GetColorBitboard(color);
-
-		while (targetSquares) {
-			int target = GetLSB(targetSquares);
-			moves.push_back(CreateMove(square, target));
-			targetSquares &= targetSquares - 1;
-		}
-		return moves;
-	}
-	
-
-	// در Board.cpp  
-	std::vector<Move> Board::generate_pawn_moves(int x, int y) {
-		uint64_t white_pawns = pawns & white;
-		uint64_t single_push = (white_pawns << 8) & ~(white | black);
-		uint64_t double_push = ((single_push & 0x0000000000FF0000) << 8) & ~(white | black);
-
-		std::vector<Move> moves;
-		Piece piece = squares[x][y];
-
-		// حرکت سفیدها به جلو  
-		if (piece == Piece::WhitePawn) {
-			// حرکت ۱ خانه  
-			if (x > 0 && squares[x - 1][y] == Piece::None) {
-				moves.push_back({ x, y, x - 1, y });
-				// حرکت ۲ خانه در اولین حرکت  
-				if (x == 6 && squares[x - 2][y] == Piece::None) {
-					moves.push_back({ x, y, x - 2, y });
-				}
-			}
-			// ضربهی اریب (چپ)  
-			if (x > 0 && y > 0 && squares[x - 1][y - 1] != Piece::None) {
-				moves.push_back({ x, y, x - 1, y - 1 });
-			}
-			// ضربهی اریب (راست)  
-			if (x > 0 && y < 7 && squares[x - 1][y + 1] != Piece::None) {
-				moves.push_back({ x, y, x - 1, y + 1 });
-			}
+		movePiece(to, from);
+
+		if (move.isCastling()) {
+			const bool kingSide = to > from;
+			movePiece(makeSquare(kingSide ? 5 : 3, rankOf(from)), makeSquare(kingSide ? 7 : 0, rankOf(from)));
 		}
-		// حرکت سیاهها به جلو (مشابه با جهت معکوس)  
-		return moves;
-	}
-	// در Board.cpp  
-	std::vector<Move> Board::generate_knight_moves(int x, int y) {
-		std::vector<Move> moves;
-		const int directions[8][2] = {
-			{-2, -1}, {-2, 1},
-			{-1, -2}, {-1, 2},
-			{1, -2},  {1, 2},
-			{2, -1},  {2, 1}
-		};
-
-		for (const auto& dir : directions) {
-			int new_x = x + dir[0];
-			int new_y = y + dir[1];
-			if (new_x >= 0 && new_x < 8 && new_y >= 0 && new_y < 8) {
-				Piece target = squares[new_x][new_y];
-				if (target == Piece::None || (is_white(piece) != is_white(target))) {
-					moves.push_back({ x, y, new_x, new_y });
-				}
-			}
-		}
-		return moves;
-	}
-	// در Board.cpp  
-	bool Board::is_in_check(bool is_white) {
-		// پیدا کردن موقعیت شاه  
-		int king_x = -1, king_y = -1;
-		for (int i = 0; i < 8; i++) {
-			for (int j = 0; j < 8; j++) {
-				if (squares[i][j] == (is_white ? Piece::WhiteKing : Piece::BlackKing)) {
-					king_x = i;
-					king_y = j;
-					break;
-				}
-			}
+		else if (st.captured != Piece::None) {
+			const Square capSq = move.isEnPassant() ? static_cast<Square>(to - pawnPush(us)) : to;
+			putPiece(st.captured, capSq);
 		}
 
-		// بررسی تمام حرکات حریف برای حمله به شاه  
-		bool in_check = false;
-		for (int i = 0; i < 8; i++) {
-			for (int j = 0; j < 8; j++) {
-				Piece p = squares[i][j];
-				if (p != Piece::None && is_white != is_white_piece(p)) {
-					auto moves = generate_moves_for_piece(i, j);
-					for (const auto& move : moves) {
-						if (move.to_x == king_x && move.to_y == king_y) {
-							in_check = true;
-							break;
-						}
-					}
-				}
-			}
-		}
-		return in_check;
+		m_stateIdx--;
+	}
+
+	// ========== حرکت پوچ ==========
+	void Board::makeNullMove() {
+		assert(m_stateIdx + 1 < MAX_GAME_PLY);
+		assert(!isInCheck());
+
+		const StateInfo& prev = m_states[m_stateIdx];
+		StateInfo& st = m_states[++m_stateIdx];
+		st.key = prev.key ^ zobristSide;
+		st.pawnKey = prev.pawnKey;
+		st.materialKey = prev.materialKey;
+		st.castling = prev.castling;
+		st.halfMoveClock = prev.halfMoveClock + 1;
+		st.pliesFromNull = 0;
+		st.captured = Piece::None;
+		st.enPassant = NoSquare;
+		if (prev.enPassant != NoSquare)
+			st.key ^= zobristEnPassant[fileOf(prev.enPassant)];
+
+		m_turn = ~m_turn;
+		m_gamePly++;
+	}
+
+	void Board::unmakeNullMove() {
+		m_turn = ~m_turn;
+		m_gamePly--;
+		m_stateIdx--;
+	}
+
+	// ========== حمله‌ها ==========
+	Bitboard Board::attackersTo(Square sq, Bitboard occupied) const {
+		return (pawnAttacks(sq, Color::Black) & getBitboard(Piece::WhitePawn))
+			| (pawnAttacks(sq, Color::White) & getBitboard(Piece::BlackPawn))
+			| (knightAttacks(sq) & getBitboard(PieceType::Knight))
+			| (kingAttacks(sq) & getBitboard(PieceType::King))
+			| (bishopAttacks(sq, occupied) & (getBitboard(PieceType::Bishop) | getBitboard(PieceType::Queen)))
+			| (rookAttacks(sq, occupied) & (getBitboard(PieceType::Rook) | getBitboard(PieceType::Queen)));
+	}
+
+	// ========== تکرار و تساوی ==========
+	bool Board::isRepetitionAt(int idx) const {
+		const StateInfo& st = m_states[idx];
+		const int end = std::min({ st.halfMoveClock, st.pliesFromNull, idx });
+		for (int i = 4; i <= end; i += 2)
+			if (m_states[idx - i].key == st.key)
+				return true;
+		return false;
 	}
 
-	bool Board::is_move_legal(const Move& move) {
-		// اعمال حرکت موقت  
-		Board temp_board = *this;
-		temp_board.apply_move(move);
-
-		// بررسی کیش بودن پس از حرکت  
-		return !temp_board.is_in_check(is_white_turn);
-	}
-	void Board::apply_move(const Move& move) {
-		// ...  
-		// غیرفعال کردن حقوق قلعه پس از حرکت شاه یا رخ  
-		if (piece_moved == Piece::WhiteKing) {
-			castling_rights.white_kingside = false;
-			castling_rights.white_queenside = false;
-		}
-		else if (piece_moved == Piece::WhiteRook) {
-			if (move.from_y == 0) castling_rights.white_queenside = false;
-			if (move.from_y == 7) castling_rights.white_kingside = false;
-		}
-		// ... (منطق مشابه برای سیاه)  
-		if (piece_moved == Piece::BlackKing) {
-			castling_rights.black_kingside = false;
-			castling_rights.black_queenside = false;
-		}
-		else if (piece_moved == Piece::BlackRook) {
-			if (move.from_y == 0) castling_rights.black_queenside = false;
-			if (move.from_y == 7) castling_rights.black_kingside = false;
+	bool Board::isDraw(int ply) const {
+		const StateInfo& st = state();
+		// قانون ۵۰ حرکت، مگر اینکه حرکت صدم مات کرده باشد
+		if (st.halfMoveClock >= 100) {
+			if (!isInCheck())
+				return true;
+			MoveList moves;
+			MoveGenerator::generateLegalMoves(*this, moves);
+			return !moves.empty();
 		}
-	}
 
-	bool Board::can_castle(bool is_white, bool kingside) {
-		if (is_white) {
-			if (kingside && !castling_rights.white_kingside) return false;
-			// بررسی مسیر و عدم کیش  
-			int x = 7;
-			return squares[x][5] == Piece::None &&
-				squares[x][6] == Piece::None &&
-				!is_in_check(is_white);
-		}else
-			{
-				if (kingside && !castling_rights.black_kingside) return false;
-				// بررسی مسیر و عدم کیش  
-				int x = 7;
-				return squares[x][5] == Piece::None &&
-					squares[x][6] == Piece::None &&
-					!is_in_check(!is_white);
-			}
-		// ... (منطق مشابه برای سیاه)  
+		const int end = std::min({ st.halfMoveClock, st.pliesFromNull, m_stateIdx });
+		for (int i = 4; i <= end; i += 2)
+			if (m_states[m_stateIdx - i].key == st.key)
+				return i < ply || isRepetitionAt(m_stateIdx - i);
+		return false;
 	}
-#include "Board.h"  
-#include <algorithm>  
-
-	// ... (توابع set_from_fen و generate_all_moves)  
-
-	bool Board::is_in_check(bool is_white) {
-		int king_x = -1, king_y = -1;
-		for (int i = 0; i < 8; i++) {
-			for (int j = 0; j < 8; j++) {
-				if (squares[i][j] == (is_white ? Piece::WhiteKing : Piece::BlackKing)) {
-					king_x = i;
-					king_y = j;
-					break;
-				}
-			}
-		}
 
-		// بررسی تمام حرکات حریف  
-		for (int i = 0; i < 8; i++) {
-			for (int j = 0; j < 8; j++) {
-				Piece p = squares[i][j];
-				if (p != Piece::None && (is_white != (p == Piece::WhitePawn || p == Piece::WhiteKing /* ... */))) {
-					auto moves = generate_moves_for_piece(i, j);
-					for (const auto& move : moves) {
-						if (move.to_x == king_x && move.to_y == king_y) {
-							return true;
-						}
-					}
-				}
+	bool Board::hasGameCycle(int ply) const {
+		const StateInfo& st = state();
+		const int end = std::min({ st.halfMoveClock, st.pliesFromNull, m_stateIdx });
+		if (end < 3)
+			return false;
+
+		const Bitboard occupied = getOccupied();
+		for (int i = 3; i <= end; i += 2) {
+			// تفاوت دو کلید دقیقاً کلید یک حرکت برگشت‌پذیر است؟
+			const uint64_t moveKey = st.key ^ m_states[m_stateIdx - i].key;
+			int j = cuckooH1(moveKey);
+			if (cuckooKeys[j] != moveKey) {
+				j = cuckooH2(moveKey);
+				if (cuckooKeys[j] != moveKey)
+					continue;
 			}
+
+			const Square s1 = cuckooMoves[j].from();
+			const Square s2 = cuckooMoves[j].to();
+			if (BetweenBB[s1][s2] & occupied)
+				continue;
+			if (ply > i)
+				return true;
+
+			// پیش از ریشه: حرکت باید مال طرف نوبت‌دار باشد و موقعیت مقصد خودش تکرار باشد
+			if (colorOf(m_board[m_board[s1] == Piece::None ? s2 : s1]) != m_turn)
+				continue;
+			if (isRepetitionAt(m_stateIdx - i))
+				return true;
 		}
 		return false;
 	}
 
-	bool Board::is_move_legal(const Move& move) {
-		Board temp = *this;
-		temp.apply_move(move);
-		return !temp.is_in_check(is_white_turn);
-	}
-
-	bool Board::is_checkmate(bool is_white) {
-		if (!is_in_check(is_white)) return false;
-		auto moves = generate_all_moves();
-		return moves.empty();
-	}
-	bool Board::can_castle(bool is_white, bool kingside) {
-		if (is_white) {
-			if (kingside && !castling_rights.white_kingside) return false;
-			if (!kingside && !castling_rights.white_queenside) return false;
-			// بررسی مسیر آزاد و عدم کیش  
-			int x = 7;
-			if (kingside) {
-				return squares[x][5] == Piece::None &&
-					squares[x][6] == Piece::None &&
-					!is_in_check(true);
-			}
-			else {
-				return squares[x][1] == Piece::None &&
-					squares[x][2] == Piece::None &&
-					squares[x][3] == Piece::None &&
-					!is_in_check(true);
-			}
-		}
-		// منطق مشابه برای سیاه  
+	void Board::compactHistory() {
+		const StateInfo& st = state();
+		const int keep = std::min({ st.halfMoveClock, st.pliesFromNull, m_stateIdx, MAX_KEPT_HISTORY });
+		if (keep == m_stateIdx)
+			return;
+		std::copy(m_states.begin() + (m_stateIdx - keep), m_states.begin() + (m_stateIdx + 1), m_states.begin());
+		m_stateIdx = keep;
 	}
-	// در Board.cpp  
-	void Board::order_moves(std::vector<Move>& moves) {
-		std::sort(moves.begin(), moves.end(), [](const Move& a, const Move& b) {
-			// اولویت به حرکات کیشدهنده یا گرفتن مهرهها  
-			return a.is_capture || a.gives_check > b.is_capture || b.gives_check;
-		});
-	}
-	void Board::set_from_fen(const std::string& fen) {
-		pawns = 0;
-		knights = 0;
-		// ... (پر کردن Bitboardها بر اساس FEN)  
-	}
-
-	int Board::evaluate() {
-		// مقادیر پایه مهره‌ها (پیاده=100، اسب=300، فیل=300، رخ=500، وزیر=900)  
-		const __m256i piece_values = _mm256_setr_epi32(
-			100, 300, 300, 500, 900, 0, 0, 0
-		);
-
-		// جمع‌کننده‌های برداری برای سفید و سیاه  
-		__m256i white_sum = _mm256_setzero_si256();
-		__m256i black_sum = _mm256_setzero_si256();
 
-		// بررسی ۸ خانه همزمان (بهینه برای AVX2)  
-		for (int i = 0; i < 64; i += 8) {
-			// بارگذاری ۸ مهره از حافظه (هر سلول ۴ بایت)  
-			__m256i pieces = _mm256_loadu_si256(
-				reinterpret_cast<const __m256i*>(&squares[i])
-			);
-
-			// جداسازی رنگ مهره‌ها (بیت ۴)  
-			__m256i color_mask = _mm256_set1_epi32(0x10);
-			__m256i is_white = _mm256_and_si256(pieces, color_mask);
-
-			// جداسازی نوع مهره (بیت‌های 0-3)  
-			__m256i piece_type = _mm256_and_si256(pieces, _mm256_set1_epi32(0x0F));
+	// ========== FEN ==========
+	void Board::setFromFEN(const std::string& fen) {
+		clearBoard();
+		m_stateIdx = 0;
+		StateInfo& st = m_states[0];
+		st = StateInfo{ 0, 0, 0, Piece::None, NoSquare, NoCastling, 0, 0 };
 
-			// تبدیل نوع مهره به مقادیر امتیازی  
-			__m256i values = _mm256_shuffle_epi8(piece_values, piece_type);
+		std::istringstream iss(fen);
+		std::string placement, turn, castling, enPassant;
+		int halfMove = 0, fullMove = 1;
+		iss >> placement >> turn >> castling >> enPassant >> halfMove >> fullMove;
 
-			// جمع‌کردن امتیازها بر اساس رنگ  
-			white_sum = _mm256_add_epi32(white_sum, _mm256_and_si256(values, _mm256_cmpeq_epi32(is_white, color_mask)));
-			black_sum = _mm256_add_epi32(black_sum, _mm256_andnot_si256(_mm256_cmpeq_epi32(is_white, color_mask), values));
+		int rank = 7, file = 0;
+		for (char c : placement) {
+			if (c == '/') {
+				rank--;
+				file = 0;
+			}
+			else if (std::isdigit(static_cast<unsigned char>(c))) {
+				file += c - '0';
+			}
+			else if (file < 8 && rank >= 0) {
+				Piece pc = charToPiece(c);
+				if (pc != Piece::None)
+					putPiece(pc, makeSquare(file, rank));
+				file++;
+			}
 		}
 
-		// جمع نهایی برداری به اسکالر  
-		int white_total[8], black_total[8];
-		_mm256_storeu_si256(reinterpret_cast<__m256i*>(white_total), white_sum);
-		_mm256_storeu_si256(reinterpret_cast<__m256i*>(black_total), black_sum);
+		m_turn = (turn == "b") ? Color::Black : Color::White;
 
-		return (white_total[0] + white_total[1] + white_total[2] + white_total[3] +
-			white_total[4] + white_total[5] + white_total[6] + white_total[7]) -
-			(black_total[0] + black_total[1] + black_total[2] + black_total[3] +
-				black_total[4] + black_total[5] + black_total[6] + black_total[7]);
-	}
-	void makeMove(Move move) {
-		// به‌روزرسانی Bitboardها با عملیات بیتی
-		pawns &= ~(1ULL << move.from);
-		pawns |= (1ULL << move.to);
-	}
-	
-}
-	// در Search.cpp
-	void Search::lazySMP(int depth) {
-		std::vector<std::thread> threads;
-		for (int i = 0; i < numThreads; i++) {
-			threads.emplace_back([this, depth]() {
-				// هر ترد جستجو را با عمق متفاوت شروع می‌کند
-				alphaBeta(depth + threadId, ...);
-			});
+		for (char c : castling) {
+			switch (c) {
+			case 'K': st.castling |= WhiteKingSide; break;
+			case 'Q': st.castling |= WhiteQueenSide; break;
+			case 'k': st.castling |= BlackKingSide; break;
+			case 'q': st.castling |= BlackQueenSide; break;
+			default: break;
+			}
 		}
-		// ...
-	}
-	void Board::setFromFEN(const std::string& fen) {
-		// پیاده‌سازی کامل پارسر FEN
-		std::istringstream iss(fen);
-		std::string token;
-
-		// پاکسازی صفحه
-		for (auto& row : squares) row.fill(Piece::None);
-
-		// بخش موقعیت مهره‌ها
-		int row = 7, col = 0;
-		iss >> token;
-		for (char c : token) {
-			if (c == '/') { row--; col = 0; continue; }
-			if (isdigit(c)) { col += c - '0'; continue; }
 
-			Piece piece = charToPiece(c);
-			squares[row][col++] = piece;
+		// مانند makeMove: آنپاسانی که قابل اجرا نیست در کلید لحاظ نمی‌شود
+		if (enPassant.size() == 2 && enPassant[0] >= 'a' && enPassant[0] <= 'h'
+			&& (enPassant[1] == '3' || enPassant[1] == '6')) {
+			Square ep = makeSquare(enPassant[0] - 'a', enPassant[1] - '1');
+			if (pawnAttacks(ep, ~m_turn) & getBitboard(PieceType::Pawn, m_turn))
+				st.enPassant = ep;
 		}
 
-		// بخش رنگ نوبت
-		iss >> token;
-		turn = (token == "w") ? Color::White : Color::Black;
-
-		// بخش حقوق قلعه
-		iss >> token;
-		castling = {
-			.whiteKingside = token.find('K') != std::string::npos,
-			.whiteQueenside = token.find('Q') != std::string::npos,
-			.blackKingside = token.find('k') != std::string::npos,
-			.blackQueenside = token.find('q') != std::string::npos
-		};
-
-		// بخش آنپاسان
-		iss >> token;
-		enPassant = (token != "-") ? std::make_optional(parseSquare(token)) : std::nullopt;
-
-		// بخش ساعت حرکت
-		iss >> halfMoveClock >> fullMoveNumber;
-	}
-	std::vector<Move> Board::generateLegalMoves() {
-		return MoveGenerator::generateLegalMoves(*this);
-	}
-
-	bool Board::isInCheck(Color color) const {
-		// پیاده‌سازی بهینه با استفاده از Bitboard
-		auto kingPos = findKing(color);
-		return isSquareAttacked(kingPos, color);
-	}
-
-	bool Board::isMoveLegal(const Move& move) {
-		Board temp = *this;
-		temp.makeMove(move);
-		return !temp.isInCheck(turn);
-	}
-#include "Board.h"
-#include "MoveGenerator.h"
-#include "BitboardUtils.h"
-#include <sstream>
-
-	using namespace ChessEngine;
-
-	Board::Board() {
-		setFromFEN("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1");
+		st.halfMoveClock = halfMove;
+		m_gamePly = 2 * (std::max(fullMove, 1) - 1) + (m_turn == Color::Black ? 1 : 0);
+		computeKeys(st);
 	}
 
-	void Board::setFromFEN(const std::string& fen) {
-		clearBoard();
-		std::istringstream iss(fen);
-		std::string token;
+	std::string Board::toFEN() const {
+		std::ostringstream fen;
 
-		// پارس کردن بخش مهره‌ها
-		int rank = 7, file = 0;
-		while (iss >> token && token != " ") {
-			for (char c : token) {
-				if (c == '/') { rank--; file = 0; }
-				else if (isdigit(c)) file += c - '0';
-				else {
-					Piece piece = charToPiece(c);
-					setPiece(Square{ rank, file }, piece);
-					file++;
+		for (int rank = 7; rank >= 0; rank--) {
+			int empty = 0;
+			for (int file = 0; file < 8; file++) {
+				Piece pc = m_board[makeSquare(file, rank)];
+				if (pc == Piece::None) {
+					empty++;
+					continue;
 				}
+				if (empty > 0) fen << empty;
+				empty = 0;
+				fen << pieceToChar(pc);
 			}
+			if (empty > 0) fen << empty;
+			if (rank > 0) fen << '/';
 		}
 
-		// پارس کردن سایر بخش‌ها
-		// ... (پیاده‌سازی کامل)
-	}
+		fen << (m_turn == Color::White ? " w " : " b ");
 
-	std::vector<Move> Board::generateLegalMoves() {
-		std::vector<Move> moves = MoveGenerator::generatePseudoLegalMoves(*this);
+		const uint8_t cr = state().castling;
+		if (cr & WhiteKingSide) fen << 'K';
+		if (cr & WhiteQueenSide) fen << 'Q';
+		if (cr & BlackKingSide) fen << 'k';
+		if (cr & BlackQueenSide) fen << 'q';
+		if (cr == NoCastling) fen << '-';
 
-		// حذف حرکات غیرقانونی
-		moves.erase(std::remove_if(moves.begin(), moves.end(),
-			[this](const Move& m) { return !isMoveLegal(m); }), moves.end());
+		const Square ep = state().enPassant;
+		if (ep == NoSquare)
+			fen << " -";
+		else
+			fen << ' ' << static_cast<char>('a' + fileOf(ep)) << static_cast<char>('1' + rankOf(ep));
 
-		return moves;
+		fen << ' ' << state().halfMoveClock << ' ' << getFullMoveNumber();
+		return fen.str();
 	}
 
-	void Board::makeMove(const Move& move) {
-		MoveHistory history;
-		history.move = move;
-		history.state = *this;
-		moveHistory.push_back(history);
-
-		// اعمال حرکت
-		// ... (پیاده‌سازی کامل با Bitboard)
+	void Board::print() const {
+		for (int rank = 7; rank >= 0; rank--) {
+			std::cout << rank + 1 << " ";
+			for (int file = 0; file < 8; file++) {
+				Piece pc = m_board[makeSquare(file, rank)];
+				std::cout << (pc == Piece::None ? '.' : pieceToChar(pc)) << " ";
+			}
+			std::cout << "\n";
+		}
+		std::cout << "  a b c d e f g h\n";
+		std::cout << "FEN: " << toFEN() << "\n";
+		std::cout << "Key: " << std::hex << getZobristKey() << std::dec << "\n";
 	}
 
-	bool Board::isInCheck(Color color) const {
-		Square kingSquare = bitScanForward(pieceBitboards[color == White ? W_KING : B_KING]);
-		return isSquareAttacked(kingSquare, ~color);
-	}
-	
 } // namespace ChessEngine
-
-
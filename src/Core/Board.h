@@ -1,260 +1,144 @@
 ﻿#ifndef CHESSENGINE_BOARD_H
 #define CHESSENGINE_BOARD_H
 
+#pragma once
 #include <array>
-#include <vector>
-#include <string>
 #include <cstdint>
-#include <immintrin.h>
-#include <vector>  
-#include <string>  
-#pragma once
-#include <optional>
+#include <string>
+#include "Types.h"
 #include "Piece.h"
 #include "Move.h"
-#include "Zobrist.h"
+#include "../../Bitboards/Bitboards.h"
+
 namespace ChessEngine {
-	// در Board.h  
 
+	constexpr const char* StartFEN = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
 
-	// انواع مهره‌ها
-	enum class Piece {
-		None = 0,
-		WhitePawn, WhiteKnight, WhiteBishop, WhiteRook, WhiteQueen, WhiteKing,
-		BlackPawn, BlackKnight, BlackBishop, BlackRook, BlackQueen, BlackKing
+	// حقوق قلعه به صورت ماسک بیتی
+	enum CastlingRight : uint8_t {
+		NoCastling = 0,
+		WhiteKingSide = 1,
+		WhiteQueenSide = 2,
+		BlackKingSide = 4,
+		BlackQueenSide = 8,
+		AllCastling = 15
 	};
-	// در Board.h  
-	struct CastlingRights {
-		bool white_kingside = true;
-		bool white_queenside = true;
-		bool black_kingside = true;
-		bool black_queenside = true;
+
+	// حداکثر طول تاریخچه (بازی + عمق جستجو)
+	constexpr int MAX_GAME_PLY = 1024;
+	// حداکثر وضعیت‌هایی که compactHistory نگه می‌دارد؛ بقیه‌ی پشته برای عمق جستجو می‌ماند
+	constexpr int MAX_KEPT_HISTORY = MAX_GAME_PLY / 2;
+
+	// هر آنچه unmakeMove برای بازگرداندن حرکت نیاز دارد و از خود حرکت به دست نمی‌آید
+	struct StateInfo {
+		uint64_t key;
+		uint64_t pawnKey;     // فقط پیاده‌ها (کلید جدول پیاده)
+		uint64_t materialKey; // فقط تعداد مهره‌ها (کلید جدول مواد)
+		Piece captured;
+		Square enPassant;
+		uint8_t castling;
+		int halfMoveClock;
+		int pliesFromNull;
 	};
-	// رنگ بازیکن
-	enum class Color { White, Black, None };
 
-	// موقعیت مهره‌ها با استفاده از Bitboard (بهینه‌سازی)
-	using Bitboard = uint64_t;
-	// کلاس اصلی صفحه شطرنج
+	// صفحه‌ی شطرنج: bitboard برای هر مهره و رنگ به همراه آرایه‌ی mailbox
+	// makeMove/unmakeMove همه چیز را درجا به‌روز می‌کنند و فقط یک StateInfo
+	// روی پشته‌ی از پیش تخصیص‌یافته ذخیره می‌شود.
 	class Board {
-			// انواع وضعیت‌های بازی
-			enum class GameState { Playing, Checkmate, Stalemate, Draw };
-
-			// ساختار حقوق قلعه
-			struct CastlingRights {
-				bool whiteKingside = true;
-				bool whiteQueenside = true;
-				bool blackKingside = true;
-				bool blackQueenside = true;
-			};
-
-			// متغیرهای عضو
-			std::array<uint64_t, 12> pieceBitboards; // [WhitePawn, WhiteKnight,... BlackKing]
-			uint64_t occupied = 0;
-			uint64_t empty = ~0ULL;
-			Color turn = Color::White;
-			CastlingRights castling;
-			std::optional<Square> enPassantTarget;
-			int halfMoveClock = 0;
-			int fullMoveNumber = 1;
-			uint64_t zobristKey = 0;
-			std::vector<MoveHistory> moveHistory;
-
-			// توابع اصلی
-			Board();
-			void setFromFEN(const std::string& fen);
-			std::vector<Move> generateLegalMoves();
-			void makeMove(const Move& move);
-			void undoMove();
-			GameState getGameState() const;
-			std::string toFEN() const;
-
-			// توابع کمکی
-			uint64_t getAttackers(Square sq, Color attackerColor) const;
-			bool isSquareAttacked(Square sq, Color attackerColor) const;
-			bool isInCheck(Color color) const;
-			bool isMoveLegal(const Move& move) const;
-
-		private:
-			// توابع داخلی
-			void clearBoard();
-			void updateOccupancy();
-			void updateZobristKey(const Move& move);
-			void handleCastling(Move& move);
-			void handleEnPassant(Move& move);
-			void handlePromotion(Move& move);
-
-		public:
-			// انواع وضعیت‌های بازی
-			enum class GameState { Playing, Checkmate, Stalemate, Draw };
-
-			// ساختار حقوق قلعه
-			struct CastlingRights {
-				bool whiteKingside = true;
-				bool whiteQueenside = true;
-				bool blackKingside = true;
-				bool blackQueenside = true;
-			};
-
-			// متغیرهای عضو
-			std::array<uint64_t, 12> pieceBitboards; // [WhitePawn, WhiteKnight,... BlackKing]
-			uint64_t occupied = 0;
-			uint64_t empty = ~0ULL;
-			Color turn = Color::White;
-			CastlingRights castling;
-			std::optional<Square> enPassantTarget;
-			int halfMoveClock = 0;
-			int fullMoveNumber = 1;
-			uint64_t zobristKey = 0;
-			std::vector<MoveHistory> moveHistory;
-
-			// توابع اصلی
-			Board();
-			void setFromFEN(const std::string& fen);
-			std::vector<Move> generateLegalMoves();
-			void makeMove(const Move& move);
-			void undoMove();
-			GameState getGameState() const;
-			std::string toFEN() const;
-
-			// توابع کمکی
-			uint64_t getAttackers(Square sq, Color attackerColor) const;
-			bool isSquareAttacked(Square sq, Color attackerColor) const;
-			bool isInCheck(Color color) const;
-			bool isMoveLegal(const Move& move) const;
-
-		private:
-			// توابع داخلی
-			void clearBoard();
-			void updateOccupancy();
-			void updateZobristKey(const Move& move);
-			void handleCastling(Move& move);
-			void handleEnPassant(Move& move);
-			void handlePromotion(Move& move);
-	
+	public:
 		Board();
-		void resetToStartPosition();
+
 		void setFromFEN(const std::string& fen);
 		std::string toFEN() const;
-
-		std::vector<Move> generateLegalMoves();
-		bool makeMove(const Move& move);
-		bool isInCheck(Color color) const;
 		void print() const;
 
-		Piece getPiece(Square sq) const;
-
-		// وضعیت بازی
-		Color turn = Color::White;
-		struct CastlingRights {
-			bool whiteKingside = true;
-			bool whiteQueenside = true;
-			bool blackKingside = true;
-			bool blackQueenside = true;
-		} castling;
-		Square enPassantTarget = { -1, -1 };
-		int halfMoveClock = 0;
-		int fullMoveNumber = 1;
-
-	private:
-		std::array<std::array<Piece, 8>, 8> m_board;
-		std::vector<Move> m_moveHistory;
-
-		bool isSquareAttacked(Square sq, Color attacker) const;
-		void clearBoard();
-	public:
-		Board();
-		uint64_t pawns = 0;
-		uint64_t knights = 0;
-		uint64_t bishops = 0;
-		uint64_t rooks;
-		uint64_t queens;
-		uint64_t kings;
-		uint64_t white;  // تمام مهرههای سفید  
-		uint64_t black;  // تمام مهرههای سیاه  
-	
-		std::vector<Move> generate_pawn_moves(int x, int y);
-		std::array<std::array<Piece, 8>, 8> squares;
-		std::vector<Move> generate_knight_moves(int x, int y);
-		std::array<std::array<Piece, 8>, 8> squares;
-		std::vector<Move> generate_pawn_moves(int x, int y);
-		bool is_in_check(bool is_white); // بررسی کیش بودن رنگ خاص  
-		bool is_move_legal(const Move& move); // بررسی قانونی بودن حرکت  
-		std::array<std::array<Piece, 8>, 8> squares;
-		bool is_white_turn = true; // نوبت بازیکن  
-		void set_from_fen(const std::string& fen);
-		std::vector<Move> generate_all_moves();
-		bool is_in_check(bool is_white);
-		bool is_move_legal(const Move& move);
-		bool is_checkmate(bool is_white);
-		std::optional<std::pair<int, int>> en_passant_target; // موقعیت پیاده قابل آنپاسان  
-		CastlingRights castling_rights;
-		std::optional<std::pair<int, int>> en_passant_target; // موقعیت پیاده هدف برای آنپاسان  
-
-		
-
-		void set_from_fen(const std::string& fen) {
-			// پیادهسازی سادهی FEN Parser برای موقعیت شروع
-			if (fen == "startpos") {
-				// تنظیم مهرهها در موقعیت اولیه
-				squares[0] = { /* رخ, اسب, فیل, وزیر, شاه, ... */ };
-				// ...
-			}
+		// ========== اعمال و بازگرداندن حرکت ==========
+		// حرکت باید شبه-قانونی باشد؛ unmakeMove باید با همان حرکت و به ترتیب معکوس صدا زده شود
+		void makeMove(Move move);
+		void unmakeMove(Move move);
+
+		// حرکت پوچ: فقط نوبت، کلید و آنپاسان عوض می‌شوند (نباید در کیش صدا زده شود)
+		void makeNullMove();
+		void unmakeNullMove();
+
+		// ========== دسترسی به وضعیت ==========
+		Piece getPiece(Square sq) const { return m_board[sq]; }
+		Bitboard getBitboard(Piece pc) const { return m_pieces[static_cast<int>(pc)]; }
+		Bitboard getBitboard(PieceType pt, Color c) const { return getBitboard(makePiece(c, pt)); }
+		Bitboard getBitboard(PieceType pt) const {
+			return getBitboard(pt, Color::White) | getBitboard(pt, Color::Black);
+		}
+		Bitboard getColorPieces(Color c) const { return m_colors[static_cast<int>(c)]; }
+		Bitboard getOccupied() const { return m_colors[0] | m_colors[1]; }
+		// آیا رنگ c مهره‌ای غیر از پیاده و شاه دارد
+		bool hasNonPawnMaterial(Color c) const {
+			return (getColorPieces(c) & ~getBitboard(PieceType::Pawn, c) & ~getBitboard(PieceType::King, c)) != 0;
+		}
+		Square getKingSquare(Color c) const { return bitScanForward(getBitboard(PieceType::King, c)); }
+
+		Color getTurn() const { return m_turn; }
+		Square getEnPassantSquare() const { return state().enPassant; }
+		uint8_t getCastlingRights() const { return state().castling; }
+		bool canCastle(CastlingRight cr) const { return (state().castling & cr) != 0; }
+		int getHalfMoveClock() const { return state().halfMoveClock; }
+		// نیم‌حرکت‌ها از آخرین حرکت پوچ (صفر: حرکت قبلی پوچ بوده است)
+		int getPliesFromNull() const { return state().pliesFromNull; }
+		int getFullMoveNumber() const { return 1 + m_gamePly / 2; }
+		int getGamePly() const { return m_gamePly; }
+		uint64_t getZobristKey() const { return state().key; }
+		uint64_t getPawnKey() const { return state().pawnKey; }
+		uint64_t getMaterialKey() const { return state().materialKey; }
+
+		// مهره‌ای که حرکت می‌گیرد (Piece::None برای حرکت آرام)
+		Piece getCapturedPiece(Move move) const {
+			return move.isEnPassant() ? makePiece(~m_turn, PieceType::Pawn) : m_board[move.to()];
 		}
-		// تولید تمام حرکات مجاز
-		std::vector<Move> generateLegalMoves() const;
-
-		// اعمال یک حرکت روی صفحه
-		void makeMove(const Move& move);
-
-		// بازگرداندن آخرین حرکت
-		void undoMove();
-
-		// تبدیل به FEN (برای ذخیره موقعیت)
-		std::string toFEN() const;
-
-		// چاپ صفحه به صورت متن
-		void print() const;
 
-		// بررسی وضعیت بازی (مات، پات، تساوی)
-		GameState getGameState() const;
+		// ========== حمله‌ها ==========
+		// همه‌ی مهره‌های هر دو رنگ که با اشغال داده‌شده به sq حمله می‌کنند
+		Bitboard attackersTo(Square sq, Bitboard occupied) const;
+		Bitboard getAttackers(Square sq, Color attacker) const {
+			return attackersTo(sq, getOccupied()) & getColorPieces(attacker);
+		}
+		bool isSquareAttacked(Square sq, Color attacker) const { return getAttackers(sq, attacker) != 0; }
+		bool isInCheck() const { return isSquareAttacked(getKingSquare(m_turn), ~m_turn); }
+
+		// ========== تکرار و تساوی ==========
+		// قانون ۵۰ حرکت یا تکرار موقعیت. فقط کلیدهای پشته‌ی وضعیت در پنجره‌ی
+		// halfMoveClock/pliesFromNull و با گام دو لایه (همان طرف) بررسی می‌شوند.
+		// تکرار درون درخت جستجو (کمتر از ply لایه قبل) کافی است؛ پیش از ریشه سه‌باره لازم است.
+		bool isDraw(int ply) const;
+		// آیا طرف نوبت‌دار با یک حرکت برگشتی می‌تواند موقعیتی قبلی را تکرار کند (جدول cuckoo)
+		bool hasGameCycle(int ply) const;
+
+		// حذف وضعیت‌های پیش از آخرین حرکت برگشت‌ناپذیر (تکرار هرگز از آن عقب‌تر را نمی‌بیند).
+		// هنگام بازپخش حرکات بازی صدا زده می‌شود تا بازی طولانی از پشته بیرون نزند؛
+		// پس از آن unmakeMove فقط تا همین وضعیت‌های نگه‌داشته‌شده مجاز است.
+		void compactHistory();
 
 	private:
-		// داده‌های صفحه
-		std::array<Piece, 64> m_squares;
-		Color m_turn;
-		bool m_castlingRights[4]; // [WhiteKingSide, WhiteQueenSide, BlackKingSide, BlackQueenSide]
-		Square m_enPassantSquare;
-		int m_halfMoveClock;
-		int m_fullMoveNumber;
-
-		// تاریخچه حرکات برای undo
-		std::vector<MoveHistory> m_moveHistory;
-
-		// توابع کمکی
-		Bitboard getPawnAttacks(Square sq, Color color) const;
-		Bitboard getKnightAttacks(Square sq) const;
-		bool isSquareAttacked(Square sq, Color attackerColor) const;
-	};
-
-	// ساختار حرکت
-	struct Move {
-		Square from;
-		Square to;
-		Piece piece;
-		Piece promotion; // برای ارتقاء پیاده
-		MoveType type;   // عادی، En Passant، قلعه، ارتقاء
-		int from_x, from_y;
-		int to_x, to_y;
-		std::string to_string() const {
-			char cols[] = { 'a','b','c','d','e','f','g','h' };
-			return std::string(1, cols[from_y]) + std::to_string(8 - from_x) +
-				std::string(1, cols[to_y]) + std::to_string(8 - to_x);
-		}
+		void clearBoard();
+		void putPiece(Piece pc, Square sq);
+		void removePiece(Square sq);
+		void movePiece(Square from, Square to);
+		// هر سه کلید از صفر (فقط در setFromFEN؛ makeMove آن‌ها را افزایشی نگه می‌دارد)
+		void computeKeys(StateInfo& st) const;
+		// آیا وضعیت idx خودش تکرار یک وضعیت قدیمی‌تر است
+		bool isRepetitionAt(int idx) const;
+
+		const StateInfo& state() const { return m_states[m_stateIdx]; }
+
+		std::array<Piece, 64> m_board;
+		std::array<Bitboard, PIECE_NB> m_pieces;
+		std::array<Bitboard, 2> m_colors;
+		Color m_turn = Color::White;
+		int m_gamePly = 0;
+
+		// پشته‌ی وضعیت‌ها؛ با اندیس (نه اشاره‌گر) تا کپی Board امن بماند
+		std::array<StateInfo, MAX_GAME_PLY> m_states;
+		int m_stateIdx = 0;
 	};
 
+} // namespace ChessEngine
 
-
-
-	
 #endif // CHESSENGINE_BOARD_H
@@ -1,95 +1,79 @@
 ﻿#ifndef MOVE_H
 #define MOVE_H
 
+#pragma once
+#include <cstdint>
 #include <string>
-#pragma once  
-#include <string>  
-
-
-// موقعیت روی صفحه شطرنج (ردیف و ستون)
-struct Position {
-	int row;
-	int col;
-	Position(int r = -1, int c = -1) : row(r), col(c) {}
-};
-
-// انواع مهره‌های شطرنج
-enum class PieceType {
-	None,
-	Pawn,
-	Knight,
-	Bishop,
-	Rook,
-	Queen,
-	King
-};
-
-// پرچم‌های حرکت (قلعه، آنپاسان، ارتقاء و ...)
-enum class MoveFlag {
-	None,
-	Castling,
-	EnPassant,
-	Promotion,
-	Capture
-};
-struct Move {
-	Square from;
-	Square to;
-	Piece piece;
-	Piece captured;
-	PieceType promotion = PieceType::None;
-	bool isEnPassant = false;
-	bool isCastling = false;
-
-	std::string toUCI() const;
-	bool operator==(const Move& other) const;
-};
-
-class Move {
-private:
-	Position startPos;    // موقعیت شروع
-	Position endPos;      // موقعیت پایان
-	PieceType piece;      // نوع مهره حرکت‌دهنده
-	PieceType capturedPiece; // مهره حذفشده (در صورت وجود)
-	PieceType promotion;  // نوع مهره ارتقاء (برای پیاده)
-	MoveFlag flag;        // پرچم حرکت خاص
-
-	int from_x, from_y;
-	int to_x, to_y;
-	std::string to_string() const {
-		const char cols[] = { 'a', 'b', 'c', 'd', 'e', 'f', 'g', 'h' };
-		return std::string(1, cols[from_y]) + std::to_string(8 - from_x) +
-			std::string(1, cols[to_y]) + std::to_string(8 - to_x);
-	}
-public:
-	// سازنده‌ها
-	Move();
-	Move(Position start, Position end, PieceType p, PieceType captured = PieceType::None, MoveFlag f = MoveFlag::None);
-	Move(Position start, Position end, PieceType p, PieceType captured, PieceType promo, MoveFlag f);
-
-	// متدهای دسترسی (getters)
-	Position getStart() const;
-	Position getEnd() const;
-	PieceType getPiece() const;
-	PieceType getCapturedPiece() const;
-	PieceType getPromotion() const;
-	MoveFlag getFlag() const;
-
-	// بررسی معتبر بودن حرکت
-	bool isValid() const;
-
-	// بررسی نوع حرکت
-	bool isCapture() const;
-	bool isPromotion() const;
-	bool isCastling() const;
-	bool isEnPassant() const;
-
-	// تبدیل به نماد استاندارد شطرنج (مثال: e2e4, e7e8q)
-	std::string toString() const;
-
-	// عملگرهای مقایسه
-	bool operator==(const Move& other) const;
-	bool operator!=(const Move& other) const;
-};
-
-#endif
\ No newline at end of file
+#include "Types.h"
+
+namespace ChessEngine {
+
+	// نوع حرکت (دو بیت بالای حرکت فشرده)
+	enum class MoveFlag : uint8_t {
+		Normal = 0,
+		Promotion = 1,
+		EnPassant = 2,
+		Castling = 3
+	};
+
+	// حرکت فشرده‌ی ۱۶ بیتی
+	// [0..5] خانه‌ی مبدأ | [6..11] خانه‌ی مقصد
+	// [12..13] مهره‌ی ارتقاء (اسب تا وزیر) | [14..15] نوع حرکت
+	// قلعه به صورت حرکت شاه ذخیره می‌شود (مثال: e1g1)
+	class Move {
+	public:
+		// سازنده‌ی پیش‌فرض مقدار اولیه ندارد تا MoveList هزینه‌ی ساخت نداشته باشد؛
+		// برای حرکت تهی از Move::none() استفاده کنید.
+		Move() = default;
+		constexpr explicit Move(uint16_t data) : m_data(data) {}
+		constexpr Move(Square from, Square to, MoveFlag flag = MoveFlag::Normal,
+			PieceType promotion = PieceType::Knight)
+			: m_data(static_cast<uint16_t>(from
+				| (to << 6)
+				| ((static_cast<int>(promotion) - static_cast<int>(PieceType::Knight)) << 12)
+				| (static_cast<int>(flag) << 14))) {}
+
+		static constexpr Move none() { return Move(static_cast<uint16_t>(0)); }
+		// حرکت پوچ (null move): مبدأ و مقصد هر دو b1
+		static constexpr Move null() { return Move(static_cast<uint16_t>(65)); }
+
+		constexpr Square from() const { return static_cast<Square>(m_data & 0x3F); }
+		constexpr Square to() const { return static_cast<Square>((m_data >> 6) & 0x3F); }
+		constexpr MoveFlag flag() const { return static_cast<MoveFlag>(m_data >> 14); }
+		constexpr PieceType promotion() const {
+			return static_cast<PieceType>(((m_data >> 12) & 3) + static_cast<int>(PieceType::Knight));
+		}
+
+		constexpr bool isPromotion() const { return flag() == MoveFlag::Promotion; }
+		constexpr bool isEnPassant() const { return flag() == MoveFlag::EnPassant; }
+		constexpr bool isCastling() const { return flag() == MoveFlag::Castling; }
+
+		// none و null هر دو مبدأ و مقصد یکسان دارند
+		constexpr bool isValid() const { return from() != to(); }
+		constexpr explicit operator bool() const { return m_data != 0; }
+
+		constexpr uint16_t raw() const { return m_data; }
+
+		// تبدیل به نماد UCI (مثال: e2e4, e7e8q)
+		std::string toUCI() const;
+
+		constexpr bool operator==(const Move& other) const { return m_data == other.m_data; }
+		constexpr bool operator!=(const Move& other) const { return m_data != other.m_data; }
+
+	private:
+		uint16_t m_data;
+	};
+
+	static_assert(sizeof(Move) == 2, "Move must stay 16 bits");
+
+	// حرکت به همراه امتیاز مرتب‌سازی؛ فقط در لیست‌های حرکت استفاده می‌شود
+	struct ScoredMove : public Move {
+		int score;
+
+		ScoredMove() = default;
+		ScoredMove(const Move& m, int s = 0) : Move(m), score(s) {}
+	};
+
+} // namespace ChessEngine
+
+#endif
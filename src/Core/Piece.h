@@ -1,17 +1,41 @@
 #pragma once
+#include <cctype>
+#include "Types.h"
 
 namespace ChessEngine {
-	enum class PieceType {
-		None, Pawn, Knight, Bishop, Rook, Queen, King
+	// مهره‌ی روی خانه: بیت ۳ رنگ و بیت‌های ۰..۲ نوع مهره است
+	enum class Piece : uint8_t {
+		None = 0,
+		WhitePawn = 1, WhiteKnight, WhiteBishop, WhiteRook, WhiteQueen, WhiteKing,
+		BlackPawn = 9, BlackKnight, BlackBishop, BlackRook, BlackQueen, BlackKing
 	};
 
-	enum class Color { White, Black };
+	// اندازه‌ی جداولی که با Piece اندیس می‌شوند
+	constexpr int PIECE_NB = 16;
 
-	struct Piece {
-		PieceType type = PieceType::None;
-		Color color = Color::White;
+	constexpr Piece makePiece(Color c, PieceType pt) {
+		return static_cast<Piece>((static_cast<int>(c) << 3) | static_cast<int>(pt));
+	}
+	constexpr PieceType typeOf(Piece p) { return static_cast<PieceType>(static_cast<int>(p) & 7); }
+	constexpr Color colorOf(Piece p) { return static_cast<Color>(static_cast<int>(p) >> 3); }
 
-		explicit operator bool() const { return type != PieceType::None; }
-		char symbol() const;
-	};
-}
\ No newline at end of file
+	// نماد FEN مهره (حروف بزرگ برای سفید)
+	inline char pieceToChar(Piece p) {
+		constexpr const char* symbols = " PNBRQK  pnbrqk";
+		return symbols[static_cast<int>(p)];
+	}
+
+	inline Piece charToPiece(char c) {
+		PieceType pt = PieceType::None;
+		switch (std::tolower(static_cast<unsigned char>(c))) {
+		case 'p': pt = PieceType::Pawn; break;
+		case 'n': pt = PieceType::Knight; break;
+		case 'b': pt = PieceType::Bishop; break;
+		case 'r': pt = PieceType::Rook; break;
+		case 'q': pt = PieceType::Queen; break;
+		case 'k': pt = PieceType::King; break;
+		default: return Piece::None;
+		}
+		return makePiece(std::isupper(static_cast<unsigned char>(c)) ? Color::White : Color::Black, pt);
+	}
+}
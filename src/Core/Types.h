@@ -2,14 +2,28 @@
 #include <cstdint>
 
 namespace ChessEngine {
-	enum class Color { White, Black };
-	enum class PieceType { None, Pawn, Knight, Bishop, Rook, Queen, King };
+	using Bitboard = uint64_t;
 
-	struct Square {
-		int8_t file; // 0-7 (a-h)
-		int8_t rank; // 0-7 (1-8)
+	enum class Color : uint8_t { White, Black };
+	enum class PieceType : uint8_t { None, Pawn, Knight, Bishop, Rook, Queen, King };
 
-		Square(int8_t f = -1, int8_t r = -1) : file(f), rank(r) {}
-		bool isValid() const { return file >= 0 && file < 8 && rank >= 0 && rank < 8; }
+	// شماره‌ی خانه: a1 = 0, b1 = 1, ..., h8 = 63
+	enum Square : int {
+		A1, B1, C1, D1, E1, F1, G1, H1,
+		A2, B2, C2, D2, E2, F2, G2, H2,
+		A3, B3, C3, D3, E3, F3, G3, H3,
+		A4, B4, C4, D4, E4, F4, G4, H4,
+		A5, B5, C5, D5, E5, F5, G5, H5,
+		A6, B6, C6, D6, E6, F6, G6, H6,
+		A7, B7, C7, D7, E7, F7, G7, H7,
+		A8, B8, C8, D8, E8, F8, G8, H8,
+		NoSquare
 	};
-}
\ No newline at end of file
+
+	constexpr Color operator~(Color c) { return static_cast<Color>(static_cast<int>(c) ^ 1); }
+
+	constexpr int fileOf(Square sq) { return sq & 7; }
+	constexpr int rankOf(Square sq) { return sq >> 3; }
+	constexpr Square makeSquare(int file, int rank) { return static_cast<Square>(rank * 8 + file); }
+	constexpr bool isValidSquare(int sq) { return sq >= A1 && sq <= H8; }
+}
@@ -0,0 +1,80 @@
+#include "Zobrist.h"
+#include "../../Bitboards/Bitboards.h"
+#include <random>
+#include <utility>
+
+namespace ChessEngine {
+
+	uint64_t zobristKeys[PIECE_NB][64];
+	uint64_t zobristCastling[16];
+	uint64_t zobristEnPassant[8];
+	uint64_t zobristSide;
+	uint64_t zobristMaterial[PIECE_NB][MaxPieceCount];
+	uint64_t zobristNoPawns;
+
+	uint64_t cuckooKeys[CuckooSize];
+	Move cuckooMoves[CuckooSize];
+
+	namespace {
+		// حملات روی صفحه‌ی خالی (بدون وابستگی به جداول جادویی)
+		Bitboard emptyBoardAttacks(PieceType pt, Square sq) {
+			switch (pt) {
+			case PieceType::Knight: return KnightAttacks[sq];
+			case PieceType::Bishop: return slidingAttacks(PieceType::Bishop, sq, 0);
+			case PieceType::Rook: return slidingAttacks(PieceType::Rook, sq, 0);
+			case PieceType::Queen: return slidingAttacks(PieceType::Bishop, sq, 0) | slidingAttacks(PieceType::Rook, sq, 0);
+			case PieceType::King: return KingAttacks[sq];
+			default: return 0;
+			}
+		}
+
+		void initCuckoo() {
+			for (uint64_t& key : cuckooKeys)
+				key = 0;
+			for (Move& move : cuckooMoves)
+				move = Move::none();
+
+			for (Color c : { Color::White, Color::Black }) {
+				for (int t = static_cast<int>(PieceType::Knight); t <= static_cast<int>(PieceType::King); ++t) {
+					const Piece pc = makePiece(c, static_cast<PieceType>(t));
+					for (int s1 = 0; s1 < 64; ++s1) {
+						for (int s2 = s1 + 1; s2 < 64; ++s2) {
+							if (!(emptyBoardAttacks(typeOf(pc), static_cast<Square>(s1)) & (1ULL << s2)))
+								continue;
+
+							// درج cuckoo: ورودی قبلی به خانه‌ی جایگزینش رانده می‌شود
+							Move move(static_cast<Square>(s1), static_cast<Square>(s2));
+							uint64_t key = zobristKeys[static_cast<int>(pc)][s1] ^ zobristKeys[static_cast<int>(pc)][s2] ^ zobristSide;
+							int i = cuckooH1(key);
+							while (true) {
+								std::swap(cuckooKeys[i], key);
+								std::swap(cuckooMoves[i], move);
+								if (!move)
+									break;
+								i = (i == cuckooH1(key)) ? cuckooH2(key) : cuckooH1(key);
+							}
+						}
+					}
+				}
+			}
+		}
+	}
+
+	void initZobrist() {
+		std::mt19937_64 rng(12345); // seed ثابت برای تکرارپذیری تست‌ها
+		for (int p = 0; p < PIECE_NB; ++p)
+			for (int sq = 0; sq < 64; ++sq)
+				zobristKeys[p][sq] = rng();
+		for (uint64_t& key : zobristCastling)
+			key = rng();
+		for (uint64_t& key : zobristEnPassant)
+			key = rng();
+		zobristSide = rng();
+		for (int p = 0; p < PIECE_NB; ++p)
+			for (int n = 0; n < MaxPieceCount; ++n)
+				zobristMaterial[p][n] = rng();
+		zobristNoPawns = rng();
+		initCuckoo();
+	}
+
+}
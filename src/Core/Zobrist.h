@@ -1,54 +1,30 @@
 ﻿#pragma once
 #include <cstdint>
-// در Zobrist.h
-#include <random>
-// در Zobrist.h
-namespace ChessEngine {
-	e
-}
-namespace ChessEngine {
-class Zobrist {
-public:
-	    void initZobrist() {
-		std::mt19937_64 rng(12345);
-		for (int i = 0; i < 12; i++)
-			for (int j = 0; j < 64; j++)
-				zobristKeys[i][j] = rng();
-	}
-	static void init();
-	static uint64_t computeHash(const ChessBoard& board);
-
-private:
-	extern uint64_t zobristKeys[12][64]; // 6 نوع مهره × 2 رنگ × 64 خانه
-	extern uint64_t zobristCastling[16]; // 4 بیت حقوق قلعه (2^4=16)
-	extern uint64_t zobristEnPassant[8]; // 8 ستون ممکن برای آنپاسان
+#include "Piece.h"
+#include "Move.h"
 
-	void initZobrist() {
-		std::mt19937_64 rng(12345); // seed ثابت برای تست
-		for (int i = 0; i < 12; ++i)
-			for (int j = 0; j < 64; ++j)
-				zobristKeys[i][j] = rng();
-		// ...
-	}
-	static uint64_t zobristTable[8][8][12]; // 12 = 6 مهره * 2 رنگ
-
-	uint64_t keys[8][8][12]; // [x][y][piece]
-	uint64_t turnKey;
-public:
-	Zobrist() { /* مقداردهی تصادفی */ }
-	uint64_t computeHash(const ChessBoard& board) const;
-	uint64_t computeZobristHash(const ChessBoard& board) {
-		uint64_t hash = 0;
-		for (const auto&[pos, piece] : board.pieces) {
-			int pieceIndex = static_cast<int>(piece.type) + 6 * static_cast<int>(piece.color);
-			hash ^= zobristTable[pos.x][pos.y][pieceIndex];
-		}
-		return hash;
-	}
-
-};
+namespace ChessEngine {
+	// کلیدهای تصادفی Zobrist؛ یک بار با initZobrist() پر می‌شوند
+	extern uint64_t zobristKeys[PIECE_NB][64]; // [مهره][خانه]
+	extern uint64_t zobristCastling[16];       // ترکیب ۴ بیت حقوق قلعه
+	extern uint64_t zobristEnPassant[8];       // ستون خانه‌ی آنپاسان
+	extern uint64_t zobristSide;               // نوبت سیاه
 
+	// کلید مواد: برای n مهره‌ی pc کلیدهای [pc][0..n-1] XOR می‌شوند (حداکثر ۱۰ مهره‌ی هم‌نوع)
+	constexpr int MaxPieceCount = 10;
+	extern uint64_t zobristMaterial[PIECE_NB][MaxPieceCount];
+	// پایه‌ی کلید پیاده‌ها تا ساختار بدون پیاده کلید صفر نداشته باشد
+	extern uint64_t zobristNoPawns;
 
+	// جدول cuckoo برای تشخیص تکرار در راه: کلید هر حرکت برگشت‌پذیر مهره‌ی غیرپیاده
+	// (zobristKeys[pc][from] ^ zobristKeys[pc][to] ^ zobristSide) در یکی از دو خانه‌ی
+	// H1 یا H2 قرار دارد، پس جستجو با دو دسترسی حافظه انجام می‌شود
+	constexpr int CuckooSize = 8192;
+	extern uint64_t cuckooKeys[CuckooSize];
+	extern Move cuckooMoves[CuckooSize];
+	constexpr int cuckooH1(uint64_t key) { return static_cast<int>(key & (CuckooSize - 1)); }
+	constexpr int cuckooH2(uint64_t key) { return static_cast<int>((key >> 16) & (CuckooSize - 1)); }
 
-	
-}
\ No newline at end of file
+	// کلیدها و سپس جدول cuckoo را پر می‌کند
+	void initZobrist();
+}
@@ -1,348 +1,346 @@
 ﻿#include "MoveGenerator.h"
-// در MoveGenerator.cpp
-#include "../utils/LookupTables.h"
-
-#include "Board.h"
-#include <bitset>
 #include <algorithm>
 
 namespace ChessEngine {
 
-	// جدول از پیش محاسبه‌شده برای حرکت اسب
-	constexpr Bitboard knightAttacks[64] = { /* ... */ };
-
-	// جدول از پیش محاسبه‌شده برای حرکت شاه
-	constexpr Bitboard kingAttacks[64] = { /* ... */ };
-
-	// در MoveGenerator.cpp
-	uint64_t knightAttacks = precomputedKnightAttacks[square];
-
-
-	std::vector<Move> MoveGenerator::generateLegalMoves(const Board& board) {
-		std::vector<Move> moves = generatePseudoLegalMoves(board);
-
-		// حذف حرکاتی که شاه را در معرض کیش قرار می‌دهند
-		auto it = std::remove_if(moves.begin(), moves.end(),
-			[&](const Move& move) { return !isMoveLegal(board, move); });
-		moves.erase(it, moves.end());
-
-		return moves;
+	// ========== تولید حرکات قانونی ==========
+	void MoveGenerator::generate(const Board& board, GenType type, MoveList& moves) {
+		GenState gs;
+		gs.type = type;
+		gs.us = board.getTurn();
+		gs.them = ~gs.us;
+		gs.king = board.getKingSquare(gs.us);
+		gs.occupied = board.getOccupied();
+		gs.targets = type == GenType::Captures ? board.getColorPieces(gs.them)
+			: type == GenType::Quiets ? ~gs.occupied
+			: ~board.getColorPieces(gs.us);
+		gs.checkers = board.getAttackers(gs.king, gs.them);
+		gs.pinned = calculatePinned(board, gs.us);
+
+		generateKingMoves(board, gs, moves);
+
+		// در کیش دوتایی فقط شاه می‌تواند حرکت کند
+		if (moreThanOne(gs.checkers))
+			return;
+
+		gs.checkMask = gs.checkers
+			? BetweenBB[gs.king][bitScanForward(gs.checkers)] | gs.checkers
+			: ~0ULL;
+
+		generatePawnMoves(board, gs, moves);
+		if (type != GenType::Quiets)
+			generateEnPassantMoves(board, gs, moves);
+		generatePieceMoves(board, gs, PieceType::Knight, moves);
+		generatePieceMoves(board, gs, PieceType::Bishop, moves);
+		generatePieceMoves(board, gs, PieceType::Rook, moves);
+		generatePieceMoves(board, gs, PieceType::Queen, moves);
+
+		if (!gs.checkers && type != GenType::Captures)
+			generateCastlingMoves(board, gs, moves);
 	}
 
-	std::vector<Move> MoveGenerator::generatePseudoLegalMoves(const Board& board) {
-		std::vector<Move> moves;
-		Color color = board.getTurn();
+	bool MoveGenerator::isPseudoLegal(const Board& board, Move move) {
+		if (!move.isValid())
+			return false;
+
+		const Color us = board.getTurn();
+		const Square from = move.from();
+		const Square to = move.to();
+		const Piece pc = board.getPiece(from);
+		if (pc == Piece::None || colorOf(pc) != us || (board.getColorPieces(us) & squareBB(to)))
+			return false;
+
+		const PieceType pt = typeOf(pc);
+		const Bitboard occupied = board.getOccupied();
+
+		if (move.isCastling()) {
+			if (pt != PieceType::King || board.isInCheck())
+				return false;
+			GenState gs;
+			gs.us = us;
+			gs.them = ~us;
+			gs.king = from;
+			gs.occupied = occupied;
+			MoveList castling;
+			generateCastlingMoves(board, gs, castling);
+			return castling.contains(move);
+		}
 
-		generatePawnMoves(board, moves, color);
-		generateKnightMoves(board, moves, color);
-		generateBishopMoves(board, moves, color);
-		generateRookMoves(board, moves, color);
-		generateQueenMoves(board, moves, color);
-		generateKingMoves(board, moves, color);
+		if (move.isEnPassant())
+			return pt == PieceType::Pawn && to == board.getEnPassantSquare()
+				&& (pawnAttacks(from, us) & squareBB(to));
+
+		if (pt != PieceType::Pawn)
+			return !move.isPromotion() && (getAttackMask(pt, from, occupied) & squareBB(to));
+
+		// پیاده: ارتقاء فقط و همیشه روی رنک آخر
+		const Bitboard lastRank = (us == Color::White) ? Rank8 : Rank1;
+		if (move.isPromotion() != ((lastRank & squareBB(to)) != 0))
+			return false;
+
+		const int up = (us == Color::White) ? 8 : -8;
+		if (pawnAttacks(from, us) & squareBB(to))
+			return (board.getColorPieces(~us) & squareBB(to)) != 0;
+		if (to == from + up)
+			return !(occupied & squareBB(to));
+		if (to == from + 2 * up)
+			return (((us == Color::White) ? Rank2 : Rank7) & squareBB(from))
+				&& !(occupied & (squareBB(static_cast<Square>(from + up)) | squareBB(to)));
+		return false;
+	}
 
-		generateCastlingMoves(board, moves, color);
-		generateEnPassantMoves(board, moves, color);
+	bool MoveGenerator::isMoveLegal(Board& board, Move move) {
+		const Color us = board.getTurn();
+		board.makeMove(move);
+		const bool legal = !board.isSquareAttacked(board.getKingSquare(us), ~us);
+		board.unmakeMove(move);
+		return legal;
+	}
 
-		return moves;
+	Bitboard MoveGenerator::calculatePinned(const Board& board, Color color) {
+		const Color them = ~color;
+		const Square king = board.getKingSquare(color);
+		const Bitboard occupied = board.getOccupied();
+		const Bitboard queens = board.getBitboard(PieceType::Queen, them);
+
+		// مهره‌های لغزنده‌ی حریف که روی صفحه‌ی خالی به شاه می‌رسند
+		Bitboard snipers = (rookAttacks(king, 0) & (board.getBitboard(PieceType::Rook, them) | queens))
+			| (bishopAttacks(king, 0) & (board.getBitboard(PieceType::Bishop, them) | queens));
+
+		Bitboard pinned = 0;
+		while (snipers) {
+			Bitboard blockers = BetweenBB[king][popLsb(snipers)] & occupied;
+			if (blockers && !moreThanOne(blockers))
+				pinned |= blockers & board.getColorPieces(color);
+		}
+		return pinned;
 	}
 
 	// ##### تولید حرکات پیاده #####
-	void MoveGenerator::generatePawnMoves(const Board& board, std::vector<Move>& moves, Color color) {
-		Bitboard pawns = board.getPieces(PieceType::Pawn, color);
-		Bitboard enemies = board.getColorPieces(~color);
-		Bitboard empty = ~board.getAllPieces();
-		int pushDir = (color == Color::White) ? 8 : -8;
-
-		while (pawns) {
-			Square sq = popLsb(pawns);
-			Square forward = sq + pushDir;
-
-			// حرکت به جلو
-			if (board.getPiece(forward) == Piece::None) {
-				addPawnMove(moves, sq, forward, color, board);
-
-				// حرکت دوگانه (فقط در ردیف شروع)
-				if ((color == Color::White && rankOf(sq) == 1) ||
-					(color == Color::Black && rankOf(sq) == 6)) {
-					Square doublePush = forward + pushDir;
-					if (board.getPiece(doublePush) == Piece::None) {
-						moves.emplace_back(sq, doublePush, Piece::None, MoveType::DoublePawnPush);
-					}
+	void MoveGenerator::generatePawnMoves(const Board& board, const GenState& gs, MoveList& moves) {
+		const Bitboard empty = ~gs.occupied;
+		const Bitboard enemies = board.getColorPieces(gs.them);
+		const Bitboard promotionRank = (gs.us == Color::White) ? Rank8 : Rank1;
+		const Bitboard startRank = (gs.us == Color::White) ? Rank2 : Rank7;
+		const int up = (gs.us == Color::White) ? 8 : -8;
+
+		for (Bitboard pawns = board.getBitboard(PieceType::Pawn, gs.us); pawns; ) {
+			const Square from = popLsb(pawns);
+			Bitboard allowed = gs.checkMask;
+			if (gs.pinned & squareBB(from))
+				allowed &= LineBB[gs.king][from];
+
+			// گرفتن‌ها و ارتقاها در دسته‌ی Captures، حرکات ساده‌ی رو به جلو در Quiets
+			Bitboard targets = gs.type != GenType::Quiets ? pawnAttacks(from, gs.us) & enemies : 0;
+			const Square push = static_cast<Square>(from + up);
+			if (empty & squareBB(push)) {
+				if (promotionRank & squareBB(push)) {
+					if (gs.type != GenType::Quiets)
+						targets |= squareBB(push);
+				}
+				else if (gs.type != GenType::Captures) {
+					targets |= squareBB(push);
+					const Square dbl = static_cast<Square>(push + up);
+					if ((startRank & squareBB(from)) && (empty & squareBB(dbl)))
+						targets |= squareBB(dbl);
 				}
 			}
 
-			// حملات
-			Bitboard attacks = board.getPawnAttacks(sq, color) & enemies;
-			while (attacks) {
-				Square target = popLsb(attacks);
-				addPawnMove(moves, sq, target, color, board);
+			for (targets &= allowed; targets; ) {
+				const Square to = popLsb(targets);
+				if (squareBB(to) & promotionRank)
+					generatePromotions(from, to, moves);
+				else
+					moves.emplace_back(from, to);
 			}
 		}
 	}
 
-	// ##### تولید حرکات اسب #####
-	void MoveGenerator::generateKnightMoves(const Board& board, std::vector<Move>& moves, Color color) {
-		Bitboard knights = board.getPieces(PieceType::Knight, color);
-		Bitboard targets = ~board.getColorPieces(color); // فقط خانه‌های خالی یا حریف
-
-		while (knights) {
-			Square sq = popLsb(knights);
-			Bitboard attacks = knightAttacks[sq] & targets;
-			addMoves(moves, sq, attacks, board);
+	// ##### تولید حرکات اسب، فیل، رخ و وزیر #####
+	void MoveGenerator::generatePieceMoves(const Board& board, const GenState& gs, PieceType pt, MoveList& moves) {
+		for (Bitboard pieces = board.getBitboard(pt, gs.us); pieces; ) {
+			const Square from = popLsb(pieces);
+			Bitboard targets = getAttackMask(pt, from, gs.occupied) & gs.targets & gs.checkMask;
+			if (gs.pinned & squareBB(from))
+				targets &= LineBB[gs.king][from];
+			addMoves(from, targets, moves);
 		}
 	}
 
-#include <vector>
-#include "ChessBoard.h"
-#include "Move.h"
-
-	class MoveGenerator {
-	public:
-		
-		
-		static void generateBishopMoves(const ChessBoard& board, int row, int col, std::vector<Move>& moves) {
-			// جهت‌های حرکت فیل (۴ جهت قطری)
-			const int directions[4][2] = { {1,1}, {1,-1}, {-1,1}, {-1,-1} };
-
-			for (auto& dir : directions) {
-				for (int step = 1; step < 8; step++) {
-					int newRow = row + dir[0] * step;
-					int newCol = col + dir[1] * step;
-
-					if (!board.isValidSquare(newRow, newCol)) break;
-
-					Piece targetPiece = board.getPiece(newRow, newCol);
-					if (targetPiece == Piece::None) {
-						moves.emplace_back(row, col, newRow, newCol);
-					}
-					else {
-						if (board.isEnemy(newRow, newCol))
-							moves.emplace_back(row, col, newRow, newCol, MoveType::Capture);
-						break;
-					}
-				}
-			}
+	void MoveGenerator::generateKingMoves(const Board& board, const GenState& gs, MoveList& moves) {
+		// شاه از اشغال حذف می‌شود تا خانه‌های پشت شاه روی خط کیش هم ناامن دیده شوند
+		const Bitboard occupied = gs.occupied ^ squareBB(gs.king);
+		for (Bitboard targets = kingAttacks(gs.king) & gs.targets; targets; ) {
+			const Square to = popLsb(targets);
+			if (!calculateAttackers(board, to, gs.them, occupied))
+				moves.emplace_back(gs.king, to);
 		}
+	}
 
-		static void generateRookMoves(const ChessBoard& board, int row, int col, std::vector<Move>& moves) {
-			// جهت‌های حرکت رخ (۴ جهت مستقیم)
-			const int directions[4][2] = { {1,0}, {-1,0}, {0,1}, {0,-1} };
-
-			for (auto& dir : directions) {
-				for (int step = 1; step < 8; step++) {
-					int newRow = row + dir[0] * step;
-					int newCol = col + dir[1] * step;
-
-					if (!board.isValidSquare(newRow, newCol)) break;
-
-					Piece targetPiece = board.getPiece(newRow, newCol);
-					if (targetPiece == Piece::None) {
-						moves.emplace_back(row, col, newRow, newCol);
-					}
-					else {
-						if (board.isEnemy(newRow, newCol))
-							moves.emplace_back(row, col, newRow, newCol, MoveType::Capture);
-						break;
-					}
-				}
-			}
-		}
+	// ##### حرکات خاص #####
+	void MoveGenerator::generateCastlingMoves(const Board& board, const GenState& gs, MoveList& moves) {
+		const bool white = (gs.us == Color::White);
 
-		static void generateQueenMoves(const ChessBoard& board, int row, int col, std::vector<Move>& moves) {
-			// ترکیب حرکات فیل و رخ
-			generateBishopMoves(board, row, col, moves);
-			generateRookMoves(board, row, col, moves);
+		// کوتاه: f و g خالی و امن
+		if (board.canCastle(white ? WhiteKingSide : BlackKingSide)) {
+			const Square f = white ? F1 : F8, g = white ? G1 : G8;
+			if (!(gs.occupied & (squareBB(f) | squareBB(g)))
+				&& !board.isSquareAttacked(f, gs.them) && !board.isSquareAttacked(g, gs.them))
+				moves.emplace_back(gs.king, g, MoveFlag::Castling);
 		}
 
-		static void generateKingMoves(const ChessBoard& board, int row, int col, std::vector<Move>& moves) {
-			// حرکات عادی شاه (۸ جهت)
-			const int directions[8][2] = { {1,0}, {-1,0}, {0,1}, {0,-1}, {1,1}, {1,-1}, {-1,1}, {-1,-1} };
-
-			for (auto& dir : directions) {
-				int newRow = row + dir[0];
-				int newCol = col + dir[1];
-
-				if (board.isValidSquare(newRow, newCol)) {
-					if (board.isEmpty(newRow, newCol)) {
-						moves.emplace_back(row, col, newRow, newCol);
-					}
-					else if (board.isEnemy(newRow, newCol)) {
-						moves.emplace_back(row, col, newRow, newCol, MoveType::Capture);
-					}
-				}
-			}
-
-			// حرکات قلعه
-			generateCastlingMoves(board, row, col, moves);
+		// بلند: b، c و d خالی؛ فقط c و d باید امن باشند
+		if (board.canCastle(white ? WhiteQueenSide : BlackQueenSide)) {
+			const Square b = white ? B1 : B8, c = white ? C1 : C8, d = white ? D1 : D8;
+			if (!(gs.occupied & (squareBB(b) | squareBB(c) | squareBB(d)))
+				&& !board.isSquareAttacked(c, gs.them) && !board.isSquareAttacked(d, gs.them))
+				moves.emplace_back(gs.king, c, MoveFlag::Castling);
 		}
+	}
 
-		static void generateCastlingMoves(const ChessBoard& board, int row, int col, std::vector<Move>& moves) {
-			if (!board.canCastle(board.getTurnColor())) return;
-
-			const bool isWhite = board.isWhiteTurn();
-			const int backRank = isWhite ? 0 : 7;
-
-			// قلعه کوتاه (Kingside)
-			if (board.hasCastleRight(isWhite, CastleSide::King) &&
-				board.isEmpty(backRank, 5) &&
-				board.isEmpty(backRank, 6) &&
-				!board.isSquareAttacked(backRank, 4) &&
-				!board.isSquareAttacked(backRank, 5))
-			{
-				moves.emplace_back(MoveType::Castle, Square{ row,col }, Square{ backRank,6 });
-			}
-
-			// قلعه بلند (Queenside)
-			if (board.hasCastleRight(isWhite, CastleSide::Queen) &&
-				board.isEmpty(backRank, 3) &&
-				board.isEmpty(backRank, 2) &&
-				board.isEmpty(backRank, 1) &&
-				!board.isSquareAttacked(backRank, 4) &&
-				!board.isSquareAttacked(backRank, 3))
-			{
-				moves.emplace_back(MoveType::Castle, Square{ row,col }, Square{ backRank,2 });
-			}
-		}
-
-		static void generateEnPassantMoves(const ChessBoard& board, int row, int col, std::vector<Move>& moves) {
-			Square epSquare = board.getEnPassantTarget();
-			if (epSquare == Square::Invalid) return;
-
-			const int direction = board.isWhiteTurn() ? 1 : -1;
-			const int epRow = epSquare.row;
-			const int epCol = epSquare.col;
-
-			// بررسی پیاده‌های قابل انجام En Passant
-			if (row + direction == epRow && (col == epCol + 1 || col == epCol - 1)) {
-				moves.emplace_back(MoveType::EnPassant, Square{ row,col }, epSquare);
-			}
+	void MoveGenerator::generateEnPassantMoves(const Board& board, const GenState& gs, MoveList& moves) {
+		const Square ep = board.getEnPassantSquare();
+		if (ep == NoSquare)
+			return;
+
+		const Square captured = static_cast<Square>(ep + (gs.us == Color::White ? -8 : 8));
+		const Bitboard queens = board.getBitboard(PieceType::Queen, gs.them);
+		const Bitboard rooks = board.getBitboard(PieceType::Rook, gs.them) | queens;
+		const Bitboard bishops = board.getBitboard(PieceType::Bishop, gs.them) | queens;
+
+		// دو پیاده هم‌زمان از یک ردیف حذف می‌شوند، پس ماسک میخ کافی نیست؛
+		// اشغال پس از حرکت مستقیماً بررسی می‌شود
+		for (Bitboard b = pawnAttacks(ep, gs.them) & board.getBitboard(PieceType::Pawn, gs.us); b; ) {
+			const Square from = popLsb(b);
+			const Bitboard occupied = (gs.occupied ^ squareBB(from) ^ squareBB(captured)) | squareBB(ep);
+			if ((gs.checkers & ~squareBB(captured) & ~(rooks | bishops))
+				|| (rookAttacks(gs.king, occupied) & rooks)
+				|| (bishopAttacks(gs.king, occupied) & bishops))
+				continue;
+			moves.emplace_back(from, ep, MoveFlag::EnPassant);
 		}
-	};
+	}
 
-	// ##### بررسی قانونی بودن حرکت #####
-	bool MoveGenerator::isMoveLegal(const Board& board, const Move& move) {
-		Board tempBoard = board;
-		tempBoard.makeMove(move);
-		return !tempBoard.isKingInCheck(board.getTurn());
+	void MoveGenerator::generatePromotions(Square from, Square to, MoveList& moves) {
+		moves.emplace_back(from, to, MoveFlag::Promotion, PieceType::Queen);
+		moves.emplace_back(from, to, MoveFlag::Promotion, PieceType::Rook);
+		moves.emplace_back(from, to, MoveFlag::Promotion, PieceType::Bishop);
+		moves.emplace_back(from, to, MoveFlag::Promotion, PieceType::Knight);
 	}
 
 	// ##### توابع کمکی #####
-	void MoveGenerator::addMoves(std::vector<Move>& moves, Square from, Bitboard targets, const Board& board) {
+	void MoveGenerator::addMoves(Square from, Bitboard targets, MoveList& moves) {
 		while (targets) {
-			Square to = popLsb(targets);
-			Piece captured = board.getPiece(to);
-			moves.emplace_back(from, to, captured);
+			moves.emplace_back(from, popLsb(targets));
 		}
 	}
 
-	void MoveGenerator::addPawnMove(...) {
-		// بررسی ارتقا
-		if ((color == Color::White && rankOf(to) == 7) ||
-			(color == Color::Black && rankOf(to) == 0)) {
-			generatePromotions(move, moves);
-		}
-		else {
-			moves.emplace_back(...);
+	Bitboard MoveGenerator::getAttackMask(PieceType pt, Square sq, Bitboard occupied) {
+		switch (pt) {
+		case PieceType::Knight: return knightAttacks(sq);
+		case PieceType::Bishop: return bishopAttacks(sq, occupied);
+		case PieceType::Rook: return rookAttacks(sq, occupied);
+		case PieceType::Queen: return queenAttacks(sq, occupied);
+		case PieceType::King: return kingAttacks(sq);
+		default: return 0;
 		}
 	}
 
-	void MoveGenerator::generatePromotions(...) {
-		moves.emplace_back(..., Piece::Queen);
-		moves.emplace_back(..., Piece::Rook);
-		moves.emplace_back(..., Piece::Bishop);
-		moves.emplace_back(..., Piece::Knight);
+	Bitboard MoveGenerator::calculateAttackers(const Board& board, Square sq, Color attacker, Bitboard occupied) {
+		return board.attackersTo(sq, occupied) & board.getColorPieces(attacker);
 	}
 
-} // namespace ChessEngine
-// در فایل MoveGenerator.cpp
-#include "MoveGenerator.hpp"
-
-std::vector<uint16_t> MoveGenerator::generateLegalMoves(const Board& board) {
-	std::vector<uint16_t> moves;
-	uint64_t allies = board.turn == 0 ?
-		(board.pawns[0] | board.knights[0] | board.bishops[0] |
-			board.rooks[0] | board.queens[0] | board.kings[0]) :
-			(board.pawns[1] | board.knights[1] | board.bishops[1] |
-				board.rooks[1] | board.queens[1] | board.kings[1]);
-
-	uint64_t enemies = board.turn == 0 ?
-		(board.pawns[1] | board.knights[1] | board.bishops[1] |
-			board.rooks[1] | board.queens[1] | board.kings[1]) :
-			(board.pawns[0] | board.knights[0] | board.bishops[0] |
-				board.rooks[0] | board.queens[0] | board.kings[0]);
-
-	// تولید حرکات پیادهها
-	uint64_t pawns = board.turn == 0 ? board.pawns[0] : board.pawns[1];
-	uint64_t pawnMoves = pawnAttacks(pawns, board.turn) & enemies; // حملات
-	// افزودن حرکات به لیست...
-
-	// تولید حرکات اسبها
-	uint64_t knights = board.turn == 0 ? board.knights[0] : board.knights[1];
-	uint64_t knightMoves = knightAttacks(knights) & ~allies;
-	// افزودن حرکات به لیست...
-
-	return moves;
-}
-// MoveGenerator.cpp
-#include "../include/Bitboard/Bitboard.hpp"
-#include "../Utils/BitboardUtils.hpp"
-
-void MoveGenerator::generatePawnMoves() {
-	uint64_t attacks = BitboardUtils::pawnAttacks(pawns, color);
-	// ...
-}
-// در MoveGenerator.cpp
-void generateCastlingMoves(...) {
-	if (canCastleKingside) {
-		// بررسی مسیر ۵ و ۶ برای سفید، ۶۳ و ۶۲ برای سیاه
-		if (!isAttacked(castlePath)) addCastleMove(...);
-	}
-}
-
+	// ========== SEE ==========
+	int MoveGenerator::see(const Board& board, Move move) {
+		if (move.isCastling())
+			return 0;
+
+		const Square from = move.from();
+		const Square to = move.to();
+		Color stm = colorOf(board.getPiece(from));
+		Bitboard occupied = board.getOccupied() ^ squareBB(from);
+
+		// gain[d]: سود طرفی که d-امین گرفتن را انجام می‌دهد، اگر دنباله همان‌جا تمام شود
+		int gain[32];
+		int d = 0;
+		gain[0] = SeeValues[static_cast<int>(typeOf(board.getCapturedPiece(move)))];
+		int onSquare = SeeValues[static_cast<int>(typeOf(board.getPiece(from)))];
+		if (move.isPromotion()) {
+			gain[0] += SeeValues[static_cast<int>(move.promotion())] - SeeValues[static_cast<int>(PieceType::Pawn)];
+			onSquare = SeeValues[static_cast<int>(move.promotion())];
+		}
+		if (move.isEnPassant())
+			occupied ^= squareBB(static_cast<Square>(stm == Color::White ? to - 8 : to + 8));
+
+		const Bitboard diagonal = board.getBitboard(PieceType::Bishop) | board.getBitboard(PieceType::Queen);
+		const Bitboard straight = board.getBitboard(PieceType::Rook) | board.getBitboard(PieceType::Queen);
+
+		// مهره‌ی میخ‌شده فقط در امتداد خط میخ می‌تواند بگیرد
+		Bitboard pinnedOut = 0;
+		for (Color c : { Color::White, Color::Black })
+			pinnedOut |= calculatePinned(board, c) & ~LineBB[board.getKingSquare(c)][to];
+
+		Bitboard attackers = calculateAttackers(board, to, Color::White, occupied)
+			| calculateAttackers(board, to, Color::Black, occupied);
+		attackers &= occupied & ~pinnedOut;
+
+		while (d < 31) {
+			stm = ~stm;
+			const Bitboard stmAttackers = attackers & board.getColorPieces(stm);
+			if (!stmAttackers)
+				break;
+
+			// کم‌ارزش‌ترین مهاجم
+			PieceType pt = PieceType::Pawn;
+			Bitboard bb = 0;
+			for (; pt <= PieceType::King; pt = static_cast<PieceType>(static_cast<int>(pt) + 1))
+				if ((bb = stmAttackers & board.getBitboard(pt, stm)))
+					break;
+
+			// شاه نمی‌تواند به خانه‌ای که هنوز مهاجم دارد بگیرد
+			if (pt == PieceType::King && (attackers & board.getColorPieces(~stm)))
+				break;
+
+			++d;
+			gain[d] = onSquare - gain[d - 1];
+			onSquare = SeeValues[static_cast<int>(pt)];
+
+			// برداشتن مهاجم ممکن است لغزنده‌ای را پشت سرش آزاد کند
+			occupied ^= squareBB(bitScanForward(bb));
+			if (pt == PieceType::Pawn || pt == PieceType::Bishop || pt == PieceType::Queen)
+				attackers |= bishopAttacks(to, occupied) & diagonal;
+			if (pt == PieceType::Rook || pt == PieceType::Queen)
+				attackers |= rookAttacks(to, occupied) & straight;
+			attackers &= occupied & ~pinnedOut;
+		}
 
-std::vector<Move> MoveGenerator::GenerateEnPassantMoves(const ChessBoard& board, int row, int col) {
-	std::vector<Move> moves;
-	if (board.IsEnPassantPossible(row, col)) {
-		// ترمیم: افزودن حرکت آنپاسان معتبر  
-		Square target = { row + (board.IsWhiteToMove() ? 1 : -1), col };
-		moves.emplace_back(MoveType::EnPassant, Square{ row, col }, target);
-	}
-	return moves;
-}
-uint64_t MoveGenerator::generateKnightAttacks(Square sq) {
-	return precomputedKnightAttacks[sq]; // استفاده از جدول پیش‌محاسبه شده
-}
-#include "MoveGenerator.h"
-#include "../Core/BitboardUtils.h"
-
-using namespace ChessEngine;
-
-void MoveGenerator::generatePawnMoves(Board& board, std::vector<Move>& moves) {
-	const Color color = board.turn;
-	const uint64_t pawns = board.pieceBitboards[color == White ? W_PAWN : B_PAWN];
-
-	// محاسبه حرکات پیشرو و حملات
-	uint64_t pushes = BitboardUtils::pawnPushes(pawns, color) & board.empty;
-	uint64_t attacks = BitboardUtils::pawnAttacks(pawns, color) & board.occupiedColors[~color];
-
-	while (pushes) {
-		Square to = popLsb(pushes);
-		Square from = to - (color == White ? 8 : -8);
-		addMove(from, to, Normal, moves);
+		// هر طرف می‌تواند به جای ادامه‌ی تبادل متوقف شود
+		while (d > 0) {
+			gain[d - 1] = -std::max(-gain[d - 1], gain[d]);
+			--d;
+		}
+		return gain[0];
 	}
 
-	// ... (پیاده‌سازی کامل حملات، آنپاسان و ارتقاء)
-}
-
-void MoveGenerator::generateCastlingMoves(Board& board, std::vector<Move>& moves) {
-	if (board.isInCheck(board.turn)) return;
-
-	const uint64_t castleMask = MagicBitboards::getCastleMask(board);
-	while (castleMask) {
-		Square kingTo = popLsb(castleMask);
-		// بررسی مسیر امن
-		if (!board.isCastlePathAttacked(kingTo)) {
-			moves.emplace_back(...);
-		}
+	bool MoveGenerator::seeGE(const Board& board, Move move, int threshold) {
+		if (move.isCastling())
+			return 0 >= threshold;
+
+		// حتی بدون هیچ پاسخی به آستانه نمی‌رسد
+		int swap = SeeValues[static_cast<int>(typeOf(board.getCapturedPiece(move)))] - threshold;
+		if (move.isPromotion())
+			swap += SeeValues[static_cast<int>(move.promotion())] - SeeValues[static_cast<int>(PieceType::Pawn)];
+		if (swap < 0)
+			return false;
+
+		// حتی با از دست دادن مهاجم به آستانه می‌رسد (گرفتن قانونی با شاه هرگز پس گرفته نمی‌شود)
+		const int attacker = move.isPromotion()
+			? SeeValues[static_cast<int>(move.promotion())]
+			: SeeValues[static_cast<int>(typeOf(board.getPiece(move.from())))];
+		if (swap - attacker >= 0)
+			return true;
+
+		return see(board, move) >= threshold;
 	}
-}
\ No newline at end of file
+
+} // namespace ChessEngine
@@ -1,42 +1,73 @@
 ﻿#pragma once
 #include "../Core/Board.h"
-#include "MagicBitboards.h"
+#include "MoveList.h"
 
 namespace ChessEngine {
 
+	// دسته‌ی حرکات تولیدشده
+	// Captures: گرفتن‌ها (با آنپاسان) و همه‌ی ارتقاها | Quiets: بقیه (با قلعه)
+	enum class GenType : uint8_t { All, Captures, Quiets };
+
 	class MoveGenerator {
 	public:
-		static std::vector<Move> generateLegalMoves(Board& board);
+		// فقط حرکات قانونی تولید می‌شوند: کیش‌دهنده‌ها و مهره‌های میخ‌شده یک بار
+		// برای هر موقعیت محاسبه و مقصدها با ماسک محدود می‌شوند؛ هیچ حرکتی اعمال نمی‌شود.
+		static void generateLegalMoves(const Board& board, MoveList& moves) { generate(board, GenType::All, moves); }
+		static void generateCaptures(const Board& board, MoveList& moves) { generate(board, GenType::Captures, moves); }
+		static void generateQuiets(const Board& board, MoveList& moves) { generate(board, GenType::Quiets, moves); }
+		static void generate(const Board& board, GenType type, MoveList& moves);
 
-	private:
-		static void generatePawnMoves(Board& board, std::vector<Move>& moves);
-		static void generateKnightMoves(Board& board, std::vector<Move>& moves);
-		static void generateBishopMoves(Board& board, std::vector<Move>& moves);
-		static void generateRookMoves(Board& board, std::vector<Move>& moves);
-		static void generateQueenMoves(Board& board, std::vector<Move>& moves);
-		static void generateKingMoves(Board& board, std::vector<Move>& moves);
-		static void generateCastlingMoves(Board& board, std::vector<Move>& moves);
-	public:
-		static std::vector<Move> generateLegalMoves(Board& board);
-		static std::vector<Move> generatePseudoLegalMoves(Board& board);
+		// بررسی ارزان اینکه حرکت دلخواه (مثلاً از جدول انتقال یا killer) در این موقعیت
+		// شبه-قانونی است؛ قانونی بودن کامل را isMoveLegal بررسی می‌کند
+		static bool isPseudoLegal(const Board& board, Move move);
+
+		// بررسی قانونی بودن یک حرکت شبه-قانونی دلخواه (مثلاً از جدول انتقال)
+		// حرکت درجا اعمال و بازگردانده می‌شود؛ صفحه پس از فراخوانی بدون تغییر است
+		static bool isMoveLegal(Board& board, Move move);
+
+		// مهره‌های رنگ color که در برابر شاه خودشان میخ شده‌اند
+		static Bitboard calculatePinned(const Board& board, Color color);
+
+		// ========== ارزیابی تبادل ایستا (SEE) ==========
+		// ارزش مهره‌ها برای SEE (هم‌اندازه با Evaluator::PieceValues)
+		static constexpr int SeeValues[7] = { 0, 100, 320, 330, 500, 900, 0 };
+
+		// سود مادی دنباله‌ی گرفتن‌ها روی خانه‌ی مقصد، وقتی هر طرف با کم‌ارزش‌ترین
+		// مهره می‌گیرد و هر وقت به صرفه نبود متوقف می‌شود؛ مهاجمان پشت سر (x-ray)
+		// با جدول‌های جادویی کشف می‌شوند. قلعه صفر است.
+		static int see(const Board& board, Move move);
+		// see(move) >= threshold؛ بیشتر گرفتن‌ها بدون شبیه‌سازی کامل تصمیم می‌گیرند
+		static bool seeGE(const Board& board, Move move, int threshold);
 
 	private:
+		// وضعیت مشترک تولید حرکات در یک موقعیت
+		struct GenState {
+			Color us;
+			Color them;
+			Square king;
+			Bitboard occupied;
+			Bitboard targets;   // خانه‌های خالی یا حریف
+			Bitboard checkers;
+			Bitboard checkMask; // بدون کیش همه‌ی خانه‌ها؛ در کیش تکی: گرفتن یا سد کردن
+			Bitboard pinned;
+			GenType type;
+		};
+
 		// توابع تولید حرکت برای هر مهره
-		static void generatePawnMoves(Board& board, std::vector<Move>& moves);
-		static void generateKnightMoves(Board& board, std::vector<Move>& moves);
-		static void generateBishopMoves(Board& board, std::vector<Move>& moves);
-		static void generateRookMoves(Board& board, std::vector<Move>& moves);
-		static void generateQueenMoves(Board& board, std::vector<Move>& moves);
-		static void generateKingMoves(Board& board, std::vector<Move>& moves);
+		static void generatePawnMoves(const Board& board, const GenState& gs, MoveList& moves);
+		static void generatePieceMoves(const Board& board, const GenState& gs, PieceType pt, MoveList& moves);
+		static void generateKingMoves(const Board& board, const GenState& gs, MoveList& moves);
 
 		// توابع حرکت‌های خاص
-		static void generateCastlingMoves(Board& board, std::vector<Move>& moves);
-		static void generateEnPassantMoves(Board& board, std::vector<Move>& moves);
-		static void generatePromotions(Move& move, std::vector<Move>& moves);
+		static void generateCastlingMoves(const Board& board, const GenState& gs, MoveList& moves);
+		static void generateEnPassantMoves(const Board& board, const GenState& gs, MoveList& moves);
+		static void generatePromotions(Square from, Square to, MoveList& moves);
 
 		// توابع کمکی
-		static void addMove(Square from, Square to, MoveType type, std::vector<Move>& moves);
-		static uint64_t getAttackMask(Color color, Square sq);
+		static void addMoves(Square from, Bitboard targets, MoveList& moves);
+		static Bitboard getAttackMask(PieceType pt, Square sq, Bitboard occupied);
+		// مهاجمان رنگ attacker به sq با اشغال دلخواه (برای حرکت شاه، شاه از occupied حذف می‌شود)
+		static Bitboard calculateAttackers(const Board& board, Square sq, Color attacker, Bitboard occupied);
 	};
 
-} // namespace ChessEngine
\ No newline at end of file
+} // namespace ChessEngine
@@ -0,0 +1,62 @@
+#pragma once
+#include "../Core/Move.h"
+#include <cassert>
+#include <cstddef>
+#include <utility>
+
+namespace ChessEngine {
+
+	// حداکثر تعداد حرکات مجاز در یک موقعیت (بیشینه‌ی شناخته‌شده ۲۱۸ است)
+	constexpr int MAX_MOVES = 256;
+
+	// لیست حرکت با ظرفیت ثابت روی پشته؛ هیچ تخصیص حافظه‌ی heap ندارد
+	class MoveList {
+	public:
+		using iterator = ScoredMove*;
+		using const_iterator = const ScoredMove*;
+
+		MoveList() = default;
+		MoveList(const MoveList&) = delete;
+		MoveList& operator=(const MoveList&) = delete;
+
+		void push_back(const Move& move) {
+			assert(m_size < MAX_MOVES);
+			m_moves[m_size++] = ScoredMove(move);
+		}
+
+		template <typename... Args>
+		void emplace_back(Args&&... args) {
+			push_back(Move(std::forward<Args>(args)...));
+		}
+
+		// فقط حذف از انتهای لیست (برای الگوی remove_if/erase)
+		void erase(iterator first, iterator last) {
+			assert(last == end());
+			(void)last;
+			m_size = static_cast<size_t>(first - m_moves);
+		}
+
+		void clear() { m_size = 0; }
+		size_t size() const { return m_size; }
+		bool empty() const { return m_size == 0; }
+
+		bool contains(const Move& move) const {
+			for (const ScoredMove& m : *this)
+				if (static_cast<const Move&>(m) == move) return true;
+			return false;
+		}
+
+		ScoredMove& operator[](size_t i) { return m_moves[i]; }
+		const ScoredMove& operator[](size_t i) const { return m_moves[i]; }
+
+		iterator begin() { return m_moves; }
+		iterator end() { return m_moves + m_size; }
+		const_iterator begin() const { return m_moves; }
+		const_iterator end() const { return m_moves + m_size; }
+
+	private:
+		ScoredMove m_moves[MAX_MOVES];
+		size_t m_size = 0;
+	};
+
+} // namespace ChessEngine
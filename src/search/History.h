@@ -0,0 +1,47 @@
+// src/search/History.h
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include "../Core/Move.h"
+#include "../Core/Piece.h"
+
+namespace ChessEngine {
+
+	// ========== جداول آماری ترتیب حرکات ==========
+	// همه‌ی مقادیر int16 و در بازه‌ی [-HistoryMax, HistoryMax] هستند
+	constexpr int HistoryMax = 16384;
+
+	// به‌روزرسانی با «گرانش»: هرچه مقدار به سقف نزدیک‌تر باشد پاداش هم‌جهت کمتر اثر می‌کند،
+	// پس مقدار هرگز از بازه بیرون نمی‌زند و اطلاعات قدیمی به‌تدریج کم‌رنگ می‌شود
+	inline void updateHistory(int16_t& entry, int bonus) {
+		const int clamped = std::clamp(bonus, -HistoryMax, HistoryMax);
+		entry += static_cast<int16_t>(clamped - entry * std::abs(clamped) / HistoryMax);
+	}
+
+	// پاداش یک برش بتا در عمق داده‌شده
+	inline int historyBonus(int depth) {
+		return std::min(150 * depth - 100, 1600);
+	}
+
+	// [رنگ][from * 64 + to] (۱۶ کیلوبایت)
+	using ButterflyHistory = std::array<std::array<int16_t, 64 * 64>, 2>;
+
+	// [مهره][مقصد] برای حرکتی که پس از یک حرکت مشخص بازی می‌شود (۲ کیلوبایت)
+	using PieceToHistory = std::array<std::array<int16_t, 64>, PIECE_NB>;
+
+	// [مهره‌ی حرکت قبلی][مقصد حرکت قبلی] -> PieceToHistory
+	using ContinuationHistory = std::array<std::array<PieceToHistory, 64>, PIECE_NB>;
+
+	// بهترین پاسخ آرام به [مهره‌ی حرکت قبلی][مقصد حرکت قبلی]
+	using CounterMoveHistory = std::array<std::array<Move, 64>, PIECE_NB>;
+
+	inline int16_t& butterfly(ButterflyHistory& h, Color c, Move m) {
+		return h[static_cast<int>(c)][m.from() * 64 + m.to()];
+	}
+	inline int butterfly(const ButterflyHistory& h, Color c, Move m) {
+		return h[static_cast<int>(c)][m.from() * 64 + m.to()];
+	}
+
+} // namespace ChessEngine
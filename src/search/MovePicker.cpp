@@ -0,0 +1,205 @@
+// src/search/MovePicker.cpp
+#include "MovePicker.h"
+#include "../movegen/MoveGenerator.h"
+#include "../../evaluation/Evaluator.h"
+#include <algorithm>
+
+namespace ChessEngine {
+
+	namespace {
+		constexpr int CaptureBase = 1 << 24;
+
+		int pieceValue(Piece pc) {
+			return Evaluator::PieceValues[static_cast<int>(typeOf(pc))];
+		}
+
+		// مرتب‌سازی درجی فقط برای حرکاتی با امتیاز دست‌کم limit؛ بقیه به ترتیب تولید می‌مانند
+		void partialInsertionSort(ScoredMove* begin, ScoredMove* end, int limit) {
+			for (ScoredMove *sortedEnd = begin, *p = begin + 1; p < end; ++p) {
+				if (p->score >= limit) {
+					ScoredMove tmp = *p, *q;
+					*p = *++sortedEnd;
+					for (q = sortedEnd; q != begin && (q - 1)->score < tmp.score; --q)
+						*q = *(q - 1);
+					*q = tmp;
+				}
+			}
+		}
+	}
+
+	// ========== سازنده‌ها ==========
+	MovePicker::MovePicker(Board& board, Move ttMove, int depth, const Move* killers, Move counterMove,
+		const ButterflyHistory* mainHistory, const PieceToHistory** contHist)
+		: m_board(board), m_ttMove(ttMove), m_refutations{ killers[0], killers[1], counterMove },
+		m_mainHistory(mainHistory), m_contHist(contHist), m_depth(depth) {
+		m_stage = board.isInCheck() ? EvasionTT : MainTT;
+		// حرکت جدول انتقال بدون تولید حرکات و فقط با بررسی قانونی بودن
+		if (!ttMove || !MoveGenerator::isPseudoLegal(board, ttMove) || !MoveGenerator::isMoveLegal(board, ttMove)) {
+			m_ttMove = Move::none();
+			++m_stage;
+		}
+	}
+
+	MovePicker::MovePicker(Board& board, Move ttMove, const ButterflyHistory* mainHistory)
+		: m_board(board), m_ttMove(ttMove), m_refutations{ Move::none(), Move::none(), Move::none() },
+		m_mainHistory(mainHistory) {
+		const bool inCheck = board.isInCheck();
+		m_stage = inCheck ? EvasionTT : QSearchTT;
+		if (!ttMove
+			|| (!inCheck && board.getCapturedPiece(ttMove) == Piece::None && !ttMove.isPromotion())
+			|| !MoveGenerator::isPseudoLegal(board, ttMove) || !MoveGenerator::isMoveLegal(board, ttMove)) {
+			m_ttMove = Move::none();
+			++m_stage;
+		}
+	}
+
+	// ========== امتیازدهی ==========
+	// MVV-LVA: اول قربانی باارزش‌تر، سپس مهاجم کم‌ارزش‌تر
+	void MovePicker::scoreCaptures() {
+		for (ScoredMove* m = m_cur; m < m_end; ++m) {
+			const int victim = pieceValue(m_board.getCapturedPiece(*m))
+				+ (m->isPromotion() ? Evaluator::PieceValues[static_cast<int>(m->promotion())] : 0);
+			m->score = victim * 8 - pieceValue(m_board.getPiece(m->from())) / 8;
+		}
+	}
+
+	// history طرف نوبت‌دار به علاوه‌ی history ادامه‌ی دو حرکت قبلی
+	void MovePicker::scoreQuiets() {
+		const Color us = m_board.getTurn();
+		for (ScoredMove* m = m_cur; m < m_end; ++m) {
+			const int pc = static_cast<int>(m_board.getPiece(m->from()));
+			m->score = butterfly(*m_mainHistory, us, *m)
+				+ (*m_contHist[0])[pc][m->to()]
+				+ (*m_contHist[1])[pc][m->to()];
+		}
+	}
+
+	void MovePicker::scoreEvasions() {
+		for (ScoredMove* m = m_cur; m < m_end; ++m) {
+			const Piece captured = m_board.getCapturedPiece(*m);
+			if (captured != Piece::None || m->isPromotion())
+				m->score = CaptureBase + pieceValue(captured) * 8 - pieceValue(m_board.getPiece(m->from())) / 8;
+			else
+				m->score = butterfly(*m_mainHistory, m_board.getTurn(), *m);
+		}
+	}
+
+	// بهترین حرکت باقی‌مانده به m_cur منتقل و برگردانده می‌شود (مرتب‌سازی انتخابی تنبل)
+	Move MovePicker::selectBest() {
+		std::swap(*m_cur, *std::max_element(m_cur, m_end, [](const ScoredMove& a, const ScoredMove& b) {
+			return a.score < b.score;
+		}));
+		return *m_cur++;
+	}
+
+	// ========== دسته‌بندی ==========
+	// گرفتن خوب: تبادل روی خانه‌ی مقصد دست‌کم سر به سر است
+	bool MovePicker::isGoodCapture(Move move) const {
+		return MoveGenerator::seeGE(m_board, move, 0);
+	}
+
+	bool MovePicker::isRefutation(Move move) const {
+		return move == m_refutations[0] || move == m_refutations[1] || move == m_refutations[2];
+	}
+
+	// killer یا countermove فقط وقتی که در این موقعیت یک حرکت آرام قانونی و تکراری نباشد
+	bool MovePicker::isValidRefutation(Move move) const {
+		for (int i = 0; i < m_refutationIdx - 1; ++i)
+			if (m_refutations[i] == move)
+				return false;
+		return move && move != m_ttMove
+			&& MoveGenerator::isPseudoLegal(m_board, move)
+			&& m_board.getCapturedPiece(move) == Piece::None && !move.isPromotion()
+			&& MoveGenerator::isMoveLegal(m_board, move);
+	}
+
+	// ========== حرکت بعدی ==========
+	Move MovePicker::next(bool skipQuiets) {
+		switch (m_stage) {
+		case MainTT:
+		case EvasionTT:
+		case QSearchTT:
+			++m_stage;
+			return m_ttMove;
+
+		case CaptureInit:
+		case QCaptureInit:
+			m_cur = m_badCapturesEnd = m_moves.begin();
+			MoveGenerator::generateCaptures(m_board, m_moves);
+			m_end = m_moves.end();
+			scoreCaptures();
+			++m_stage;
+			return next(skipQuiets);
+
+		case GoodCaptures:
+			while (m_cur < m_end) {
+				const Move move = selectBest();
+				if (move == m_ttMove)
+					continue;
+				if (isGoodCapture(move))
+					return move;
+				// گرفتن بد برای آخر کار به ابتدای لیست منتقل می‌شود
+				*m_badCapturesEnd++ = *(m_cur - 1);
+			}
+			++m_stage;
+			return next(skipQuiets);
+
+		case Refutation:
+			while (!skipQuiets && m_refutationIdx < 3) {
+				const Move move = m_refutations[m_refutationIdx++];
+				if (isValidRefutation(move))
+					return move;
+			}
+			++m_stage;
+			return next(skipQuiets);
+
+		case QuietInit:
+			if (!skipQuiets) {
+				m_cur = m_end;
+				MoveGenerator::generateQuiets(m_board, m_moves);
+				m_end = m_moves.end();
+				scoreQuiets();
+				partialInsertionSort(m_cur, m_end, -3000 * m_depth);
+			}
+			++m_stage;
+			return next(skipQuiets);
+
+		case Quiets:
+			while (!skipQuiets && m_cur < m_end) {
+				const Move move = *m_cur++;
+				if (move != m_ttMove && !isRefutation(move))
+					return move;
+			}
+			m_cur = m_moves.begin();
+			++m_stage;
+			return next(skipQuiets);
+
+		case BadCaptures:
+			while (m_cur < m_badCapturesEnd) {
+				const Move move = *m_cur++;
+				if (move != m_ttMove)
+					return move;
+			}
+			return Move::none();
+
+		case EvasionInit:
+			m_cur = m_moves.begin();
+			MoveGenerator::generateLegalMoves(m_board, m_moves);
+			m_end = m_moves.end();
+			scoreEvasions();
+			++m_stage;
+			return next(skipQuiets);
+
+		case Evasions:
+		case QCaptures:
+			while (m_cur < m_end) {
+				const Move move = selectBest();
+				if (move != m_ttMove)
+					return move;
+			}
+			return Move::none();
+		}
+		return Move::none();
+	}
+
+} // namespace ChessEngine
@@ -0,0 +1,60 @@
+// src/search/MovePicker.h
+#pragma once
+#include <cstdint>
+#include "../Core/Board.h"
+#include "../movegen/MoveList.h"
+#include "History.h"
+
+namespace ChessEngine {
+
+	// انتخاب مرحله‌ای و تنبل حرکات: هر دسته فقط وقتی تولید و امتیازدهی می‌شود که
+	// جستجو واقعاً به آن برسد. بیشتر گره‌ها با حرکت جدول انتقال یا اولین گرفتن
+	// برش می‌خورند و هرگز حرکات آرام را تولید نمی‌کنند.
+	//   جستجوی اصلی: TT -> گرفتن‌های خوب -> killer1 -> killer2 -> countermove -> آرام‌ها -> گرفتن‌های بد
+	//   در کیش:       TT -> همه‌ی حرکات فرار
+	//   جستجوی سکون:  TT (فقط اگر گرفتن یا ارتقاء باشد) -> گرفتن‌ها و ارتقاها
+	class MovePicker {
+	public:
+		// contHist: جداول ادامه‌ی یک و دو لایه قبل برای امتیازدهی حرکات آرام
+		MovePicker(Board& board, Move ttMove, int depth, const Move* killers, Move counterMove,
+			const ButterflyHistory* mainHistory, const PieceToHistory** contHist);
+		MovePicker(Board& board, Move ttMove, const ButterflyHistory* mainHistory);
+		MovePicker(const MovePicker&) = delete;
+		MovePicker& operator=(const MovePicker&) = delete;
+
+		// حرکت قانونی بعدی یا Move::none() در پایان
+		// skipQuiets: حرکات آرام باقی‌مانده (و killerها) رد می‌شوند
+		Move next(bool skipQuiets = false);
+
+	private:
+		enum Stage : uint8_t {
+			MainTT, CaptureInit, GoodCaptures, Refutation, QuietInit, Quiets, BadCaptures,
+			EvasionTT, EvasionInit, Evasions,
+			QSearchTT, QCaptureInit, QCaptures
+		};
+
+		void scoreCaptures();
+		void scoreQuiets();
+		void scoreEvasions();
+		Move selectBest();
+
+		bool isGoodCapture(Move move) const;
+		bool isRefutation(Move move) const;
+		bool isValidRefutation(Move move) const;
+
+		Board& m_board;
+		Move m_ttMove;
+		Move m_refutations[3];
+		const ButterflyHistory* m_mainHistory;
+		const PieceToHistory** m_contHist = nullptr;
+		int m_depth = 0;
+
+		uint8_t m_stage;
+		int m_refutationIdx = 0;
+		ScoredMove* m_cur = nullptr;
+		ScoredMove* m_end = nullptr;
+		ScoredMove* m_badCapturesEnd = nullptr;
+		MoveList m_moves;
+	};
+
+} // namespace ChessEngine
@@ -0,0 +1,302 @@
+// src/search/Perft.cpp
+#include "Perft.h"
+#include "../movegen/MoveGenerator.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <memory>
+#include <ostream>
+#include <thread>
+#include <vector>
+
+namespace ChessEngine {
+
+	namespace {
+		using Clock = std::chrono::steady_clock;
+
+		double secondsSince(Clock::time_point start) {
+			return std::chrono::duration<double>(Clock::now() - start).count();
+		}
+
+		uint64_t nps(uint64_t nodes, double seconds) {
+			return seconds > 0 ? static_cast<uint64_t>(nodes / seconds) : 0;
+		}
+
+		// جدول هش perft بدون قفل، با همان طرح XOR جدول انتقال:
+		// data = (nodes << 8) | depth و check = key ^ data
+		class PerftHash {
+		public:
+			explicit PerftHash(size_t megabytes) {
+				size_t count = 1;
+				while (count * 2 * sizeof(Entry) <= megabytes * 1024 * 1024)
+					count *= 2;
+				m_entries = std::make_unique<Entry[]>(count);
+				m_mask = count - 1;
+				for (size_t i = 0; i < count; i++) {
+					m_entries[i].check.store(0, std::memory_order_relaxed);
+					m_entries[i].data.store(0, std::memory_order_relaxed);
+				}
+			}
+
+			bool probe(uint64_t key, int depth, uint64_t& nodes) const {
+				const Entry& e = m_entries[key & m_mask];
+				const uint64_t data = e.data.load(std::memory_order_relaxed);
+				const uint64_t check = e.check.load(std::memory_order_relaxed);
+				if ((check ^ data) != key || static_cast<int>(data & 0xFF) != depth)
+					return false;
+				nodes = data >> 8;
+				return true;
+			}
+
+			void store(uint64_t key, int depth, uint64_t nodes) {
+				Entry& e = m_entries[key & m_mask];
+				const uint64_t data = (nodes << 8) | static_cast<uint64_t>(depth);
+				e.data.store(data, std::memory_order_relaxed);
+				e.check.store(key ^ data, std::memory_order_relaxed);
+			}
+
+		private:
+			struct Entry {
+				std::atomic<uint64_t> check;
+				std::atomic<uint64_t> data;
+			};
+
+			std::unique_ptr<Entry[]> m_entries;
+			size_t m_mask = 0;
+		};
+
+		// با stop شمارش نیمه‌کاره برمی‌گردد و در جدول ذخیره نمی‌شود
+		uint64_t perftHashed(Board& board, int depth, PerftHash* hash, const std::atomic<bool>* stop) {
+			if ((!hash && !stop) || depth < 2)
+				return perft(board, depth);
+			if (stop && stop->load(std::memory_order_relaxed))
+				return 0;
+
+			const uint64_t key = board.getZobristKey();
+			uint64_t nodes = 0;
+			if (hash && hash->probe(key, depth, nodes))
+				return nodes;
+
+			MoveList moves;
+			MoveGenerator::generateLegalMoves(board, moves);
+			for (const Move& move : moves) {
+				board.makeMove(move);
+				nodes += perftHashed(board, depth - 1, hash, stop);
+				board.unmakeMove(move);
+			}
+
+			if (hash && !(stop && stop->load(std::memory_order_relaxed)))
+				hash->store(key, depth, nodes);
+			return nodes;
+		}
+
+		// شمارش زیردرخت هر حرکت ریشه؛ کارها جفت‌های (حرکت ریشه، پاسخ) هستند
+		// تا حتی با تعداد کم حرکات ریشه همه‌ی تردها کار داشته باشند
+		std::vector<uint64_t> perftRootMoves(Board& board, int depth, const MoveList& rootMoves,
+			int threadCount, PerftHash* hash, const std::atomic<bool>* stop) {
+			std::vector<uint64_t> counts(rootMoves.size(), 0);
+			if (depth <= 1) {
+				for (uint64_t& c : counts)
+					c = depth == 1 ? 1 : 0;
+				return counts;
+			}
+
+			struct Task {
+				size_t root;
+				Move reply;
+			};
+			std::vector<Task> tasks;
+			for (size_t i = 0; i < rootMoves.size(); i++) {
+				board.makeMove(rootMoves[i]);
+				MoveList replies;
+				MoveGenerator::generateLegalMoves(board, replies);
+				if (depth == 2)
+					counts[i] = replies.size();
+				else
+					for (const Move& reply : replies)
+						tasks.push_back({ i, reply });
+				board.unmakeMove(rootMoves[i]);
+			}
+
+			threadCount = std::max(1, threadCount);
+			std::atomic<size_t> nextTask{ 0 };
+			std::vector<std::vector<uint64_t>> partial(threadCount, std::vector<uint64_t>(rootMoves.size(), 0));
+
+			auto worker = [&](int id) {
+				Board local = board;
+				for (size_t t; (t = nextTask.fetch_add(1, std::memory_order_relaxed)) < tasks.size(); ) {
+					if (stop && stop->load(std::memory_order_relaxed))
+						break;
+					const Move root = rootMoves[tasks[t].root];
+					local.makeMove(root);
+					local.makeMove(tasks[t].reply);
+					partial[id][tasks[t].root] += perftHashed(local, depth - 2, hash, stop);
+					local.unmakeMove(tasks[t].reply);
+					local.unmakeMove(root);
+				}
+			};
+
+			std::vector<std::thread> threads;
+			for (int id = 1; id < threadCount; id++)
+				threads.emplace_back(worker, id);
+			worker(0);
+			for (std::thread& th : threads)
+				th.join();
+
+			for (const auto& p : partial)
+				for (size_t i = 0; i < counts.size(); i++)
+					counts[i] += p[i];
+			return counts;
+		}
+
+		std::unique_ptr<PerftHash> makeHash(const PerftOptions& options) {
+			return options.hashMB > 0 ? std::make_unique<PerftHash>(options.hashMB) : nullptr;
+		}
+
+		uint64_t perftParallel(Board& board, int depth, int threadCount, PerftHash* hash,
+			const std::atomic<bool>* stop) {
+			if (depth <= 0)
+				return 1;
+
+			MoveList moves;
+			MoveGenerator::generateLegalMoves(board, moves);
+
+			uint64_t total = 0;
+			for (uint64_t nodes : perftRootMoves(board, depth, moves, threadCount, hash, stop))
+				total += nodes;
+			return total;
+		}
+	}
+
+	// منابع: chessprogramming.org/Perft_Results و مجموعه‌ی حالت‌های مرزی Martin Sedlak
+	const std::array<PerftPosition, 20> PerftSuite = { {
+		{ "startpos", StartFEN,
+			{ 20, 400, 8902, 197281, 4865609, 119060324, 0 } },
+		{ "kiwipete", "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+			{ 48, 2039, 97862, 4085603, 193690690, 0, 0 } },
+		{ "position3", "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+			{ 14, 191, 2812, 43238, 674624, 11030083, 178633661 } },
+		{ "position4", "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+			{ 6, 264, 9467, 422333, 15833292, 706045033, 0 } },
+		{ "position5", "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+			{ 44, 1486, 62379, 2103487, 89941194, 0, 0 } },
+		{ "position6", "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10",
+			{ 46, 2079, 89890, 3894594, 164075551, 0, 0 } },
+		{ "illegal-ep-1", "3k4/3p4/8/K1P4r/8/8/8/8 b - - 0 1",
+			{ 0, 0, 0, 0, 0, 1134888, 0 } },
+		{ "illegal-ep-2", "8/8/4k3/8/2p5/8/B2P2K1/8 w - - 0 1",
+			{ 0, 0, 0, 0, 0, 1015133, 0 } },
+		{ "ep-gives-check", "8/8/1k6/2b5/2pP4/8/5K2/8 b - d3 0 1",
+			{ 0, 0, 0, 0, 0, 1440467, 0 } },
+		{ "short-castle-check", "5k2/8/8/8/8/8/8/4K2R w K - 0 1",
+			{ 0, 0, 0, 0, 0, 661072, 0 } },
+		{ "long-castle-check", "3k4/8/8/8/8/8/8/R3K3 w Q - 0 1",
+			{ 0, 0, 0, 0, 0, 803711, 0 } },
+		{ "castle-rights", "r3k2r/1b4bq/8/8/8/8/7B/R3K2R w KQkq - 0 1",
+			{ 0, 0, 0, 1274206, 0, 0, 0 } },
+		{ "castle-prevented", "r3k2r/8/3Q4/8/8/5q2/8/R3K2R b KQkq - 0 1",
+			{ 0, 0, 0, 1720476, 0, 0, 0 } },
+		{ "promote-out-of-check", "2K2r2/4P3/8/8/8/8/8/3k4 w - - 0 1",
+			{ 0, 0, 0, 0, 0, 3821001, 0 } },
+		{ "discovered-check", "8/8/1P2K3/8/2n5/1q6/8/5k2 b - - 0 1",
+			{ 0, 0, 0, 0, 1004658, 0, 0 } },
+		{ "promote-give-check", "4k3/1P6/8/8/8/8/K7/8 w - - 0 1",
+			{ 0, 0, 0, 0, 0, 217342, 0 } },
+		{ "underpromote-check", "8/P1k5/K7/8/8/8/8/8 w - - 0 1",
+			{ 0, 0, 0, 0, 0, 92683, 0 } },
+		{ "self-stalemate", "K1k5/8/P7/8/8/8/8/8 w - - 0 1",
+			{ 0, 0, 0, 0, 0, 2217, 0 } },
+		{ "stalemate-checkmate-1", "8/k1P5/8/1K6/8/8/8/8 w - - 0 1",
+			{ 0, 0, 0, 0, 0, 0, 567584 } },
+		{ "stalemate-checkmate-2", "8/8/2k5/5q2/5n2/8/5K2/8 b - - 0 1",
+			{ 0, 0, 0, 23527, 0, 0, 0 } },
+	} };
+
+	// ========== شمارش ==========
+	uint64_t perft(Board& board, int depth) {
+		if (depth <= 0)
+			return 1;
+
+		MoveList moves;
+		MoveGenerator::generateLegalMoves(board, moves);
+		if (depth == 1)
+			return moves.size();
+
+		uint64_t nodes = 0;
+		for (const Move& move : moves) {
+			board.makeMove(move);
+			nodes += perft(board, depth - 1);
+			board.unmakeMove(move);
+		}
+		return nodes;
+	}
+
+	uint64_t perftParallel(Board& board, int depth, const PerftOptions& options) {
+		return perftParallel(board, depth, options.threads, makeHash(options).get(), options.stop);
+	}
+
+	uint64_t perftDivide(Board& board, int depth, std::ostream& out, const PerftOptions& options) {
+		const auto start = Clock::now();
+
+		MoveList moves;
+		MoveGenerator::generateLegalMoves(board, moves);
+		const std::vector<uint64_t> counts = perftRootMoves(board, std::max(depth, 1), moves,
+			options.threads, makeHash(options).get(), options.stop);
+
+		uint64_t total = 0;
+		for (size_t i = 0; i < moves.size(); i++) {
+			total += counts[i];
+			out << moves[i].toUCI() << ": " << counts[i] << "\n";
+		}
+
+		const double seconds = secondsSince(start);
+		if (options.stop && options.stop->load())
+			out << "\nperft stopped: counts are partial\n";
+		out << "\nNodes searched: " << total << "\n"
+			<< "Time: " << std::fixed << std::setprecision(3) << seconds << " s\n"
+			<< "NPS: " << nps(total, seconds) << std::endl;
+		return total;
+	}
+
+	// ========== مجموعه‌ی تست ==========
+	bool runPerftSuite(int maxDepth, std::ostream& out, const PerftOptions& options) {
+		const auto suiteStart = Clock::now();
+		uint64_t totalNodes = 0;
+		bool allPassed = true;
+		Board board;
+		// یک جدول برای همه‌ی موقعیت‌ها؛ کلیدها کل موقعیت را پوشش می‌دهند
+		const std::unique_ptr<PerftHash> hash = makeHash(options);
+
+		for (const PerftPosition& pos : PerftSuite) {
+			int depth = std::min<int>(maxDepth, static_cast<int>(pos.nodes.size()));
+			while (depth > 0 && pos.nodes[depth - 1] == 0)
+				depth--;
+			if (depth == 0)
+				continue;
+
+			board.setFromFEN(pos.fen);
+			const auto start = Clock::now();
+			const uint64_t nodes = perftParallel(board, depth, options.threads, hash.get(), options.stop);
+			const double seconds = secondsSince(start);
+			const bool passed = nodes == pos.nodes[depth - 1];
+
+			allPassed &= passed;
+			totalNodes += nodes;
+			out << std::left << std::setw(24) << pos.name << std::right
+				<< " depth " << depth
+				<< std::setw(12) << nodes
+				<< (passed ? "  ok  " : "  FAIL expected ")
+				<< (passed ? std::string() : std::to_string(pos.nodes[depth - 1]) + "  ")
+				<< std::setw(11) << nps(nodes, seconds) << " nps\n";
+		}
+
+		const double seconds = secondsSince(suiteStart);
+		out << "\nTotal nodes: " << totalNodes
+			<< "  time: " << std::fixed << std::setprecision(3) << seconds << " s"
+			<< "  nps: " << nps(totalNodes, seconds)
+			<< (allPassed ? "  ALL PASSED" : "  FAILURES") << std::endl;
+		return allPassed;
+	}
+
+} // namespace ChessEngine
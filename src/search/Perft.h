@@ -0,0 +1,43 @@
+// src/search/Perft.h
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include "../Core/Board.h"
+
+namespace ChessEngine {
+
+	// تعداد برگ‌های درخت حرکات قانونی تا عمق depth
+	// در آخرین لایه حرکات اعمال نمی‌شوند و فقط شمرده می‌شوند (bulk counting)
+	uint64_t perft(Board& board, int depth);
+
+	// تنظیمات اجرای موازی
+	struct PerftOptions {
+		int threads = 1;
+		size_t hashMB = 0; // صفر: بدون جدول هش
+		// در صورت مقدار داشتن، با true شدن آن کار تازه‌ای برداشته نمی‌شود (دستور stop)
+		const std::atomic<bool>* stop = nullptr;
+	};
+
+	// perft با خروجی divide: تعداد گره‌های زیر هر حرکت ریشه، سپس مجموع، زمان و nps
+	// زیردرخت‌های لایه‌ی دوم بین تردها تقسیم می‌شوند و همه یک جدول هش بدون قفل
+	// (کلید Zobrist، عمق) -> تعداد گره را به اشتراک می‌گذارند
+	uint64_t perftDivide(Board& board, int depth, std::ostream& out, const PerftOptions& options = {});
+	uint64_t perftParallel(Board& board, int depth, const PerftOptions& options);
+
+	// موقعیت استاندارد با تعداد گره‌ی شناخته‌شده؛ nodes[d - 1] برای عمق d (صفر = نامعلوم)
+	struct PerftPosition {
+		const char* name;
+		const char* fen;
+		std::array<uint64_t, 7> nodes;
+	};
+
+	extern const std::array<PerftPosition, 20> PerftSuite;
+
+	// اجرای همه‌ی موقعیت‌ها در عمیق‌ترین عمق شناخته‌شده‌ای که از maxDepth بیشتر نیست
+	// true اگر همه‌ی شمارش‌ها درست باشند
+	bool runPerftSuite(int maxDepth, std::ostream& out, const PerftOptions& options = {});
+
+} // namespace ChessEngine
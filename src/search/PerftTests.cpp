@@ -0,0 +1,72 @@
+// src/search/PerftTests.cpp
+// ابزار perft:
+//   perft [-t threads] [-h hashMB]                     اجرای مجموعه‌ی استاندارد (تا عمق ۶)
+//   perft [-t threads] [-h hashMB] suite <maxDepth>    اجرای مجموعه با عمق دلخواه
+//   perft [-t threads] [-h hashMB] <depth> [fen]       divide روی موقعیت داده‌شده (پیش‌فرض: شروع)
+#include "Perft.h"
+#include "TranspositionTable.h"
+#include <algorithm>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace ChessEngine;
+
+namespace {
+	// کل رشته باید یک عدد صحیح باشد
+	bool parseNumber(const std::string& text, long long& value) {
+		std::istringstream iss(text);
+		return (iss >> value) && (iss >> std::ws).eof();
+	}
+
+	int usage() {
+		std::cerr << "usage: perft [-t threads] [-h hashMB] [suite <maxDepth> | <depth> [fen]]" << std::endl;
+		return 2;
+	}
+}
+
+int main(int argc, char* argv[]) {
+	const long long maxThreads = std::max(1u, std::thread::hardware_concurrency());
+	PerftOptions options;
+	std::vector<std::string> args;
+	long long number = 0;
+	for (int i = 1; i < argc; i++) {
+		const std::string arg = argv[i];
+		if (arg == "-t" || arg == "-h") {
+			if (i + 1 >= argc || !parseNumber(argv[++i], number))
+				return usage();
+			if (arg == "-t")
+				options.threads = static_cast<int>(std::clamp<long long>(number, 1, maxThreads));
+			else
+				options.hashMB = static_cast<size_t>(std::clamp<long long>(number, 1,
+					static_cast<long long>(TranspositionTable::MaxSizeMB)));
+		}
+		else {
+			args.push_back(arg);
+		}
+	}
+
+	if (args.empty())
+		return runPerftSuite(6, std::cout, options) ? 0 : 1;
+
+	if (args[0] == "suite") {
+		number = 6;
+		if (args.size() > 1 && !parseNumber(args[1], number))
+			return usage();
+		return runPerftSuite(static_cast<int>(std::clamp<long long>(number, 1, 7)), std::cout, options) ? 0 : 1;
+	}
+
+	if (!parseNumber(args[0], number) || number < 1)
+		return usage();
+
+	std::string fen;
+	for (size_t i = 1; i < args.size(); i++)
+		fen += (fen.empty() ? "" : " ") + args[i];
+
+	Board board;
+	board.setFromFEN(fen.empty() ? StartFEN : fen);
+	perftDivide(board, static_cast<int>(std::min<long long>(number, MAX_GAME_PLY - 1)), std::cout, options);
+	return 0;
+}
@@ -1,308 +1,840 @@
 ﻿// src/search/Search.cpp
 #include "Search.h"
-#include "../utils/MoveGenerator.h"
+#include "MovePicker.h"
+#include "Perft.h"
+#include "TranspositionTable.h"
+#include "../movegen/MoveGenerator.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <ostream>
+#include <sstream>
+
+namespace ChessEngine {
+
+	namespace {
+		// ========== تبدیل امتیاز مات برای جدول انتقال ==========
+		// امتیاز مات نسبت به ریشه است؛ در جدول نسبت به همان گره ذخیره می‌شود
+		int scoreToTT(int score, int ply) {
+			if (score >= VALUE_MATE_IN_MAX_PLY) return score + ply;
+			if (score <= -VALUE_MATE_IN_MAX_PLY) return score - ply;
+			return score;
+		}
+
+		int scoreFromTT(int score, int ply) {
+			if (score >= VALUE_MATE_IN_MAX_PLY) return score - ply;
+			if (score <= -VALUE_MATE_IN_MAX_PLY) return score + ply;
+			return score;
+		}
 
-Search::Search(Board& board, Evaluator& evaluator)
-	: currentBoard(board), evaluator(evaluator) {}
+		// امتیاز به قالب UCI: cp <n> یا mate <n> (تعداد حرکت، نه نیم‌حرکت)
+		struct UciScore { int value; };
 
-SearchResult Search::startSearch(int depth) {
-	SearchResult result;
-	result.nodesVisited = 0;
+		std::ostream& operator<<(std::ostream& out, UciScore s) {
+			if (std::abs(s.value) >= VALUE_MATE_IN_MAX_PLY)
+				return out << "mate " << (s.value > 0 ? (VALUE_MATE - s.value + 1) / 2 : -(VALUE_MATE + s.value) / 2);
+			return out << "cp " << s.value;
+		}
 
-	int alpha = -INFINITY;
-	int beta = INFINITY;
+		// الگوی رد کردن عمق برای تردهای کمکی (اندیس ترد - ۱، به پیمانه‌ی ۲۰)
+		constexpr int SkipSize[20] = { 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 4, 4, 4, 4, 4, 4, 4, 4 };
+		constexpr int SkipPhase[20] = { 0, 1, 0, 1, 2, 3, 0, 1, 2, 3, 4, 5, 0, 1, 2, 3, 4, 5, 6, 7 };
+
+		// پنجره‌ی آرزوی اولیه (سانتی‌پیاده) و کمترین عمقی که از آن استفاده می‌کند
+		constexpr int AspirationDelta = 16;
+		constexpr int AspirationMinDepth = 4;
+
+		// هرس حرکت پوچ: کمترین عمق و عمقی که از آن جستجوی تأییدی انجام می‌شود
+		constexpr int NullMoveMinDepth = 2;
+		constexpr int NullMoveVerifyDepth = 12;
+
+		// کاهش حرکات دیررس: Reductions[عمق][شماره‌ی حرکت] = 0.75 + ln(d) * ln(m) / 2.25
+		constexpr int LmrMinDepth = 3;
+		constexpr int LmrMinMoves = 2;
+		constexpr int LmrHistoryDivisor = 1 << 14;
+
+		// هرس دلتا در جستجوی سکون: حاشیه‌ی امن روی ارزش مهره‌ی گرفته‌شده
+		constexpr int DeltaMargin = 200;
+
+		// هرس گرفتن‌های بازنده: تا این عمق، گرفتنی که بیش از SeeCaptureMargin * depth
+		// از دست می‌دهد جستجو نمی‌شود
+		constexpr int SeePruneDepth = 8;
+		constexpr int SeeCaptureMargin = 100;
+
+		const std::array<std::array<int8_t, MAX_MOVES>, MAX_PLY> Reductions = []() {
+			std::array<std::array<int8_t, MAX_MOVES>, MAX_PLY> table{};
+			for (int d = 1; d < MAX_PLY; d++)
+				for (int m = 1; m < MAX_MOVES; m++)
+					table[d][m] = static_cast<int8_t>(0.75 + std::log(d) * std::log(m) / 2.25);
+			return table;
+		}();
+
+		int reduction(int depth, int moveCount) {
+			return Reductions[std::min(depth, MAX_PLY - 1)][std::min(moveCount, MAX_MOVES - 1)];
+		}
 
-	Move bestMove = MOVE_NONE;
-	int bestValue = -INFINITY;
+	}
 
-	MoveGenerator generator(currentBoard);
-	auto moves = generator.generateLegalMoves();
+	// ##### SearchWorker #####
 
-	for (const auto& move : moves) {
-		currentBoard.makeMove(move);
-		int currentValue = alphaBeta(currentBoard, depth - 1, alpha, beta, false);
-		currentBoard.unmakeMove(move);
+	SearchWorker::SearchWorker(Search& search, int index)
+		: m_search(search), m_index(index) {
+		clear();
+		m_thread = std::thread(&SearchWorker::idleLoop, this);
+		waitForSearchFinished();
+	}
 
-		if (currentValue > bestValue) {
-			bestValue = currentValue;
-			bestMove = move;
+	SearchWorker::~SearchWorker() {
+		{
+			std::lock_guard<std::mutex> lock(m_threadMutex);
+			m_exit = true;
+			m_searching = true;
 		}
+		m_threadCv.notify_all();
+		m_thread.join();
+	}
 
-		alpha = std::max(alpha, bestValue);
+	// ========== ترد دائمی ==========
+	void SearchWorker::idleLoop() {
+		while (true) {
+			std::unique_lock<std::mutex> lock(m_threadMutex);
+			m_searching = false;
+			m_threadCv.notify_all();
+			m_threadCv.wait(lock, [this] { return m_searching; });
+			if (m_exit)
+				return;
+			lock.unlock();
+
+			if (isMainThread())
+				m_search.mainThreadSearch();
+			else
+				iterativeDeepening(m_search.m_rootBoard);
+		}
 	}
 
-	result.bestMove = bestMove;
-	result.score = bestValue;
-	return result;
-}
+	void SearchWorker::startSearching() {
+		{
+			std::lock_guard<std::mutex> lock(m_threadMutex);
+			m_searching = true;
+		}
+		m_threadCv.notify_all();
+	}
 
-int Search::alphaBeta(Board& board, int depth, int alpha, int beta, bool maximizingPlayer) {
-	if (depth == 0 || board.isGameOver()) {
-		return evaluator.evaluate(board);
+	void SearchWorker::waitForSearchFinished() {
+		std::unique_lock<std::mutex> lock(m_threadMutex);
+		m_threadCv.wait(lock, [this] { return !m_searching; });
 	}
 
-	MoveGenerator generator(board);
-	auto moves = generator.generateLegalMoves();
+	void SearchWorker::clear() {
+		for (auto& h : m_mainHistory) h.fill(0);
+		for (auto& byPiece : m_continuationHistory)
+			for (PieceToHistory& h : byPiece)
+				for (auto& row : h) row.fill(0);
+		for (auto& c : m_counterMoves) c.fill(Move::none());
+	}
 
-	if (maximizingPlayer) {
-		int value = -INFINITY;
-		for (const auto& move : moves) {
-			board.makeMove(move);
-			value = std::max(value, alphaBeta(board, depth - 1, alpha, beta, false));
-			board.unmakeMove(move);
+	bool SearchWorker::skipDepth(int depth) const {
+		if (isMainThread()) return false;
+		const int i = (m_index - 1) % 20;
+		return ((depth + m_board.getGamePly() + SkipPhase[i]) / SkipSize[i]) % 2 != 0;
+	}
 
-			alpha = std::max(alpha, value);
-			if (value >= beta)
-				break; // Beta cutoff
+	void SearchWorker::countNode() {
+		m_nodes.store(m_nodes.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+		if (isMainThread() && --m_pollCountdown <= 0) {
+			m_pollCountdown = m_search.m_pollInterval;
+			m_search.checkTime();
 		}
-		return value;
-	}
-	else {
-		int value = INFINITY;
-		for (const auto& move : moves) {
-			board.makeMove(move);
-			value = std::min(value, alphaBeta(board, depth - 1, alpha, beta, true));
-			board.unmakeMove(move);
-
-			beta = std::min(beta, value);
-			if (value <= alpha)
-				break; // Alpha cutoff
+	}
+
+	// ========== عمیق‌سازی تدریجی ==========
+	void SearchWorker::iterativeDeepening(const Board& rootBoard) {
+		m_board = rootBoard;
+		m_completedDepth = 0;
+		m_bestScore = -VALUE_INFINITE;
+		m_bestMove = Move::none();
+		m_bestMoveChanges = 0;
+		m_rootPvLength = 0;
+		for (SearchStack& frame : m_stack) {
+			frame = SearchStack();
+			frame.contHist = &m_continuationHistory[0][0];
 		}
-		return value;
-	}
-}
-// فعالسازی جستجوی موازی ساده (۲ thread)
-void Search::startParallelSearch(int depth) {
-	std::vector<std::thread> threads;
-	for (int i = 0; i < 2; i++) {
-		threads.emplace_back([this, depth]() {
-			alphaBeta(currentBoard, depth, -INFINITY, INFINITY, true);
-		});
-	}
-	for (auto& t : threads) t.join();
-}
-// مثال ساده از Minimax با هرس آلفا-بتا
-
-	// Search.cpp
-int Search::AlphaBeta(Board& board, int depth, int alpha, int beta, bool maximizingPlayer) {
-	if (depth == 0 || board.IsGameOver()) {
-		return evaluator.Evaluate(board);
-	}
-
-	auto moves = board.GenerateMoves();
-	if (maximizingPlayer) {
-		int value = -INFINITY;
-		for (Move move : moves) {
-			board.MakeMove(move);
-			value = std::max(value, AlphaBeta(board, depth - 1, alpha, beta, false));
-			board.UndoMove(move);
-			alpha = std::max(alpha, value);
-			if (alpha >= beta) break; // Beta cutoff
+
+		// ترتیب اولیه‌ی حرکات ریشه از همان انتخاب‌گر مرحله‌ای
+		m_rootMoves.clear();
+		SearchStack* ss = stackAt(0);
+		const PieceToHistory* contHist[] = { (ss - 1)->contHist, (ss - 2)->contHist };
+		MovePicker picker(m_board, Move::none(), 0, ss->killers.data(), Move::none(), &m_mainHistory, contHist);
+		while (const Move move = picker.next())
+			m_rootMoves.push_back(move);
+		if (m_rootMoves.empty())
+			return;
+
+		const TimeManager& timer = m_search.m_time;
+		int stableIterations = 0;
+		int scoreAverage = VALUE_NONE;
+		for (int depth = 1; depth <= m_search.m_limits.depth && !m_search.stopped(); ++depth) {
+			if (skipDepth(depth))
+				continue;
+			m_bestMoveChanges /= 2;
+
+			// پنجره‌ی آرزو حول امتیاز تکرار قبل؛ در شکست به سمت همان طرف باز می‌شود
+			int alpha = -VALUE_INFINITE, beta = VALUE_INFINITE;
+			int delta = AspirationDelta;
+			if (depth >= AspirationMinDepth && std::abs(m_bestScore) < VALUE_MATE_IN_MAX_PLY) {
+				alpha = std::max(m_bestScore - delta, -VALUE_INFINITE);
+				beta = std::min(m_bestScore + delta, VALUE_INFINITE);
+			}
+
+			int score;
+			while (true) {
+				score = search<Root>(depth, 0, alpha, beta);
+				if (m_search.stopped())
+					break;
+
+				if (score <= alpha) {
+					beta = (alpha + beta) / 2;
+					alpha = std::max(score - delta, -VALUE_INFINITE);
+				}
+				else if (score >= beta)
+					beta = std::min(score + delta, VALUE_INFINITE);
+				else
+					break;
+				delta += delta / 2;
+			}
+
+			// نتیجه‌ی تکرار نیمه‌کاره کنار گذاشته می‌شود
+			if (m_search.stopped())
+				break;
+
+			stableIterations = m_rootMoves[0] == m_bestMove ? stableIterations + 1 : 0;
+			m_completedDepth = depth;
+			m_bestScore = score;
+			m_bestMove = m_rootMoves[0];
+			m_rootPvLength = m_pvLength[0];
+			std::copy(m_pv[0].begin(), m_pv[0].begin() + m_rootPvLength, m_rootPv.begin());
+
+			if (!isMainThread())
+				continue;
+			m_search.reportIteration(*this);
+
+			// ========== توقف زودهنگام با زمان هدف مقیاس‌شده ==========
+			// بهترین حرکت پایدار زمان را کوتاه و تغییر حرکت یا افت امتیاز آن را بلند می‌کند
+			if (timer.enabled() && !timer.fixedTime()) {
+				const int scoreDrop = scoreAverage == VALUE_NONE ? 0 : scoreAverage - score;
+				const double target = timer.optimum() * TimeManager::scale(stableIterations, m_bestMoveChanges, scoreDrop);
+				if (timer.elapsed() > target) {
+					if (m_search.m_ponder.load(std::memory_order_relaxed))
+						m_search.m_stopOnPonderhit.store(true, std::memory_order_relaxed);
+					else
+						m_search.m_stop.store(true, std::memory_order_relaxed);
+				}
+			}
+			scoreAverage = scoreAverage == VALUE_NONE ? score : (scoreAverage + score) / 2;
 		}
-		return value;
-	}
-	else {
-		int value = INFINITY;
-		for (Move move : moves) {
-			board.MakeMove(move);
-			value = std::min(value, AlphaBeta(board, depth - 1, alpha, beta, true));
-			board.UndoMove(move);
-			beta = std::min(beta, value);
-			if (beta <= alpha) break; // Alpha cutoff
+	}
+
+	// ========== جستجوی واریانت اصلی (PVS) ==========
+	// یک تابع negamax که با نوع گره قالب‌بندی شده است؛ شاخه‌های مخصوص ریشه و PV
+	// در زمان کامپایل حذف می‌شوند و مسیر داغ NonPV (بیشتر گره‌ها) بدون آن‌ها اجرا می‌شود.
+	// اولین حرکت با پنجره‌ی کامل و بقیه با پنجره‌ی تهی جستجو می‌شوند؛
+	// فقط اگر حرکتی از پنجره‌ی تهی بالاتر برود دوباره با پنجره‌ی کامل جستجو می‌شود.
+	template <SearchWorker::NodeType nodeType>
+	int SearchWorker::search(int depth, int ply, int alpha, int beta) {
+		constexpr bool rootNode = nodeType == Root;
+		constexpr bool pvNode = nodeType != NonPV;
+		constexpr NodeType childType = pvNode ? PV : NonPV;
+
+		if (depth <= 0)
+			return quiescence<pvNode ? PV : NonPV>(ply, alpha, beta);
+
+		if constexpr (pvNode)
+			m_pvLength[ply] = ply;
+
+		countNode();
+		SearchStack* ss = stackAt(ply);
+		const bool inCheck = m_board.isInCheck();
+		ss->inCheck = inCheck;
+
+		if constexpr (!rootNode) {
+			if (m_search.stopped())
+				return 0;
+			if (ply >= MAX_PLY)
+				return m_evaluator.evaluate(m_board);
+			if (m_board.isDraw(ply))
+				return VALUE_DRAW;
+
+			// تکرار در راه: اگر حریف نتواند از تکرار فرار کند، تساوی حداقل امتیاز ماست
+			if (alpha < VALUE_DRAW && m_board.hasGameCycle(ply)) {
+				alpha = VALUE_DRAW;
+				if (alpha >= beta)
+					return alpha;
+			}
+
+			// هرس فاصله تا مات
+			alpha = std::max(alpha, matedIn(ply));
+			beta = std::min(beta, mateIn(ply + 1));
+			if (alpha >= beta)
+				return alpha;
+
+			if (inCheck)
+				depth++;
 		}
-		return value;
-	}
-	int Search::Quiescence(Board& board, int alpha, int beta) {
-		int standPat = evaluator.Evaluate(board);
-		if (standPat >= beta) return beta;
-		if (standPat > alpha) alpha = standPat;
-
-		auto captures = moveGenerator.GenerateCaptures(board);
-		for (const auto& move : captures) {
-			board.MakeMove(move);
-			int score = -Quiescence(board, -beta, -alpha);
-			board.UndoMove(move);
-			if (score >= beta) return beta;
-			if (score > alpha) alpha = score;
+
+		const uint64_t key = m_board.getZobristKey();
+		Move ttMove = Move::none();
+		TTData tt;
+		bool ttHit = false;
+		if constexpr (!rootNode) {
+			ttHit = TT.probe(key, tt);
+			if (ttHit) {
+				ttMove = tt.move;
+				const int ttScore = scoreFromTT(tt.score, ply);
+				// در گره‌های PV برش جدول انجام نمی‌شود تا واریانت اصلی کامل بماند
+				if (!pvNode && tt.depth >= depth
+					&& (tt.bound == Bound::Exact
+						|| (tt.bound == Bound::Lower && ttScore >= beta)
+						|| (tt.bound == Bound::Upper && ttScore <= alpha)))
+					return ttScore;
+			}
+
+			// جدول انتقال حرکت PV قبلی را از دست داده است: حرکت تکرار قبل جای آن را می‌گیرد
+			if (pvNode && !ttMove && onPreviousPv(ply))
+				ttMove = m_rootPv[ply];
 		}
-		return alpha;
-	}
-
-	int Search::AlphaBeta(Board& board, int depth, int alpha, int beta, bool isQuiescence) {
-		if (depth == 0) return Quiescence(board, alpha, beta); // فراخوانی Quiescence
-		// ... ادامه کد AlphaBeta
-	}
-	// مرتب‌سازی حرکات بر اساس:
-// 1. حرکات کیش
-// 2. حرکات با ارزش بالاتر (مثلاً Capture/ Promotion)
-	void Search::OrderMoves(std::vector<Move>& moves, const Board& board) {
-		std::sort(moves.begin(), moves.end(), [&](const Move& a, const Move& b) {
-			return evaluator.EvaluateMove(a, board) > evaluator.EvaluateMove(b, board);
-		});
-	}
-	Move Search::FindBestMove(Board& board, int maxDepth) {
-		Move bestMove;
-		for (int depth = 1; depth <= maxDepth; depth++) {
-			int score = AlphaBeta(board, depth, -INFINITY, INFINITY);
-			// به‌روزرسانی بهترین حرکت بر اساس عمق جستجو
+
+		// ارزیابی ایستا (در صورت وجود از جدول انتقال)
+		int staticEval = VALUE_NONE;
+		if (!inCheck)
+			staticEval = ttHit && tt.eval != VALUE_NONE ? tt.eval : m_evaluator.evaluate(m_board);
+		ss->staticEval = staticEval;
+
+		// ========== هرس حرکت پوچ ==========
+		// اگر حتی با دادن یک حرکت مجانی به حریف امتیاز از beta بالاتر بماند، گره برش می‌خورد.
+		// در کیش، پس از حرکت پوچ دیگر و وقتی فقط پیاده مانده (خطر زوگزوانگ) غیرفعال است.
+		if constexpr (!pvNode) {
+			const Color us = m_board.getTurn();
+			if (!inCheck
+				&& depth >= NullMoveMinDepth
+				&& staticEval >= beta
+				&& beta > -VALUE_MATE_IN_MAX_PLY
+				&& m_board.getPliesFromNull() > 0
+				&& m_board.hasNonPawnMaterial(us)
+				&& (ply >= m_nmpMinPly || us != m_nmpColor)) {
+				const int R = 3 + depth / 4 + std::min((staticEval - beta) / 200, 3);
+
+				ss->currentMove = Move::null();
+				ss->contHist = &m_continuationHistory[0][0];
+				m_board.makeNullMove();
+				int nullScore = -search<NonPV>(depth - R, ply + 1, -beta, -beta + 1);
+				m_board.unmakeNullMove();
+
+				if (m_search.stopped())
+					return 0;
+
+				if (nullScore >= beta) {
+					// مات اثبات‌نشده برگردانده نمی‌شود
+					if (nullScore >= VALUE_MATE_IN_MAX_PLY)
+						nullScore = beta;
+					if (m_nmpMinPly || depth < NullMoveVerifyDepth)
+						return nullScore;
+
+					// جستجوی تأییدی در عمق زیاد: حرکت پوچ برای ما در چند لایه‌ی بعد ممنوع است
+					m_nmpMinPly = ply + 3 * (depth - R) / 4;
+					m_nmpColor = us;
+					const int verified = search<NonPV>(depth - R, ply, beta - 1, beta);
+					m_nmpMinPly = 0;
+
+					if (verified >= beta)
+						return nullScore;
+				}
+			}
 		}
-		return bestMove;
-	}
-	// در Search.cpp
-	int alphaBeta(...) {
-		TTEntry* entry = tt.probe(zobristKey);
-		if (entry->depth >= depth) return entry->score;
-		// ...
-	}
-
-}
-// در Search.cpp  
-SearchResult minimax(Board board, int depth) {
-	if (depth == 0) {
-		return { Move(), board.evaluate() };
-	}
-	auto moves = board.generate_all_moves();
-	if (moves.empty()) return { Move(), -9999 }; // مات  
-
-	SearchResult best = { moves[0], -99999 };
-	for (const auto& move : moves) {
-		Board new_board = board;
-		new_board.apply_move(move);
-		int score = -minimax(new_board, depth - 1).score;
-		if (score > best.score) {
-			best = { move, score };
+
+		// امتیاز ایستا نسبت به دو لایه قبل (همان طرف) بهتر شده است؟
+		const bool improving = staticEval != VALUE_NONE
+			&& (ss - 2)->staticEval != VALUE_NONE && staticEval > (ss - 2)->staticEval;
+
+		// در ریشه حرکات از قبل تولید و بر اساس تکرار قبلی مرتب شده‌اند؛
+		// در بقیه‌ی گره‌ها انتخاب‌گر مرحله‌ای فقط به اندازه‌ی نیاز حرکت تولید می‌کند
+		const Color us = m_board.getTurn();
+		const PieceToHistory* contHist[] = { (ss - 1)->contHist, (ss - 2)->contHist };
+		const Move prevMove = (ss - 1)->currentMove;
+		const Move counterMove = prevMove.isValid()
+			? m_counterMoves[static_cast<int>(m_board.getPiece(prevMove.to()))][prevMove.to()]
+			: Move::none();
+		MovePicker picker(m_board, ttMove, depth, ss->killers.data(), counterMove, &m_mainHistory, contHist);
+
+		int bestScore = -VALUE_INFINITE;
+		Move bestMove = Move::none();
+		int moveCount = 0;
+		Move quietsSearched[64];
+		int quietCount = 0;
+		while (true) {
+			Move move;
+			if constexpr (rootNode)
+				move = moveCount < static_cast<int>(m_rootMoves.size()) ? Move(m_rootMoves[moveCount]) : Move::none();
+			else
+				move = picker.next();
+			if (!move)
+				break;
+			if (move == ss->excludedMove)
+				continue;
+
+			const bool quiet = m_board.getCapturedPiece(move) == Piece::None && !move.isPromotion();
+			moveCount++;
+			const int newDepth = depth - 1;
+
+			// ========== هرس گرفتن‌های بازنده با SEE ==========
+			if (!rootNode && !quiet && !inCheck && depth <= SeePruneDepth
+				&& bestScore > -VALUE_MATE_IN_MAX_PLY
+				&& !MoveGenerator::seeGE(m_board, move, -SeeCaptureMargin * depth))
+				continue;
+
+			const Piece movedPiece = m_board.getPiece(move.from());
+			ss->currentMove = move;
+			ss->contHist = &m_continuationHistory[static_cast<int>(movedPiece)][move.to()];
+			// فرزندی که به صورت PV جستجو نشود PV خودش را نمی‌سازد
+			if constexpr (pvNode)
+				m_pvLength[ply + 1] = ply + 1;
+
+			m_board.makeMove(move);
+			const bool givesCheck = m_board.isInCheck();
+
+			int score;
+			if (moveCount == 1)
+				score = -search<childType>(newDepth, ply + 1, -beta, -alpha);
+			else {
+				// ========== کاهش حرکات دیررس (LMR) ==========
+				// حرکات آرام دیررس با عمق کمتر و پنجره‌ی تهی جستجو می‌شوند؛
+				// اگر از alpha بالاتر رفتند با عمق کامل دوباره جستجو می‌شوند
+				int r = 0;
+				if (depth >= LmrMinDepth && moveCount > LmrMinMoves + pvNode && quiet && !inCheck && !givesCheck) {
+					r = reduction(depth, moveCount);
+					if (pvNode)
+						r--;
+					if (!improving)
+						r++;
+					if (move == ss->killers[0] || move == ss->killers[1])
+						r--;
+					const int pc = static_cast<int>(movedPiece);
+					const int stat = butterfly(m_mainHistory, us, move)
+						+ (*contHist[0])[pc][move.to()] + (*contHist[1])[pc][move.to()];
+					r -= stat / LmrHistoryDivisor;
+					r = std::clamp(r, 0, newDepth - 1);
+				}
+
+				score = -search<NonPV>(newDepth - r, ply + 1, -alpha - 1, -alpha);
+				if (r > 0 && score > alpha)
+					score = -search<NonPV>(newDepth, ply + 1, -alpha - 1, -alpha);
+				if (pvNode && score > alpha && score < beta)
+					score = -search<PV>(newDepth, ply + 1, -beta, -alpha);
+			}
+			m_board.unmakeMove(move);
+
+			if (m_search.stopped())
+				return 0;
+
+			if (score > bestScore) {
+				bestScore = score;
+				if (score > alpha) {
+					bestMove = move;
+					alpha = score;
+					if constexpr (pvNode)
+						updatePv(ply, move);
+					// بهترین حرکت ریشه به ابتدای لیست می‌رود تا تکرار بعدی با آن شروع شود
+					if constexpr (rootNode) {
+						if (moveCount > 1)
+							m_bestMoveChanges++;
+						std::rotate(m_rootMoves.begin(), m_rootMoves.begin() + moveCount - 1, m_rootMoves.begin() + moveCount);
+					}
+					if (alpha >= beta) {
+						updateStats(move, ply, depth, quietsSearched, quietCount);
+						break;
+					}
+				}
+			}
+
+			if (quiet && quietCount < 64)
+				quietsSearched[quietCount++] = move;
 		}
+
+		if (!moveCount)
+			return inCheck ? matedIn(ply) : VALUE_DRAW;
+
+		const Bound bound = bestScore >= beta ? Bound::Lower
+			: bestMove ? Bound::Exact : Bound::Upper;
+		TT.store(key, bestMove, scoreToTT(bestScore, ply), staticEval, depth, bound);
+		return bestScore;
 	}
-	return best;
-}
-bool Board::is_checkmate(bool is_white) {
-	if (!is_in_check(is_white)) return false;
-
-	// بررسی وجود حرکات قانونی  
-	auto moves = generate_all_moves();
-	return moves.empty();
-}
-// در Search.cpp  
-int alpha_beta(Board& board, int depth, int alpha, int beta, bool maximizing_player) {
-	if (depth == 0 || board.is_checkmate(!maximizing_player)) {
-		return board.evaluate();
-	}
-
-	auto moves = board.generate_all_moves();
-	if (maximizing_player) {
-		int value = -9999;
-		for (const auto& move : moves) {
-			Board new_board = board;
-			new_board.apply_move(move);
-			value = std::max(value, alpha_beta(new_board, depth - 1, alpha, beta, false));
-			alpha = std::max(alpha, value);
-			if (beta <= alpha) break; // هرس  
+
+	// ========== جستجوی سکون ==========
+	// فقط گرفتن‌ها و ارتقاها (در کیش همه‌ی فرارها) تا رسیدن به موقعیت آرام.
+	// نتیجه با عمق صفر در جدول انتقال ذخیره می‌شود و حرکتش ترتیب جستجوی اصلی را هم بهتر می‌کند.
+	template <SearchWorker::NodeType nodeType>
+	int SearchWorker::quiescence(int ply, int alpha, int beta) {
+		constexpr bool pvNode = nodeType == PV;
+
+		if constexpr (pvNode)
+			m_pvLength[ply] = ply;
+
+		countNode();
+		if (m_search.stopped())
+			return 0;
+		if (ply >= MAX_PLY)
+			return m_evaluator.evaluate(m_board);
+		if (m_board.isDraw(ply))
+			return VALUE_DRAW;
+		if (alpha < VALUE_DRAW && m_board.hasGameCycle(ply)) {
+			alpha = VALUE_DRAW;
+			if (alpha >= beta)
+				return alpha;
+		}
+
+		const bool inCheck = m_board.isInCheck();
+
+		const uint64_t key = m_board.getZobristKey();
+		TTData tt;
+		const bool ttHit = TT.probe(key, tt);
+		const Move ttMove = ttHit ? tt.move : Move::none();
+		const int ttScore = ttHit ? scoreFromTT(tt.score, ply) : VALUE_NONE;
+		if (!pvNode && ttHit
+			&& (tt.bound == Bound::Exact
+				|| (tt.bound == Bound::Lower && ttScore >= beta)
+				|| (tt.bound == Bound::Upper && ttScore <= alpha)))
+			return ttScore;
+
+		// ========== ارزش ایستا (stand pat) ==========
+		// طرف نوبت‌دار می‌تواند هیچ گرفتنی انجام ندهد؛ در کیش این گزینه وجود ندارد
+		int staticEval = VALUE_NONE;
+		int bestScore = -VALUE_INFINITE;
+		int futilityBase = -VALUE_INFINITE;
+		if (!inCheck) {
+			staticEval = ttHit && tt.eval != VALUE_NONE ? tt.eval : m_evaluator.evaluate(m_board);
+			bestScore = staticEval;
+			// امتیاز جدول اگر در جهت درست باشد تخمین دقیق‌تری است
+			if (ttHit && (tt.bound == Bound::Exact
+				|| tt.bound == (ttScore > bestScore ? Bound::Lower : Bound::Upper)))
+				bestScore = ttScore;
+
+			if (bestScore >= beta) {
+				if (!ttHit)
+					TT.store(key, Move::none(), scoreToTT(bestScore, ply), staticEval, 0, Bound::Lower);
+				return bestScore;
+			}
+			alpha = std::max(alpha, bestScore);
+			futilityBase = staticEval + DeltaMargin;
 		}
-		return value;
-	}
-	else {
-		int value = 9999;
-		for (const auto& move : moves) {
-			Board new_board = board;
-			new_board.apply_move(move);
-			value = std::min(value, alpha_beta(new_board, depth - 1, alpha, beta, true));
-			beta = std::min(beta, value);
-			if (beta <= alpha) break; // هرس  
+
+		// بیرون از کیش فقط گرفتن‌ها و ارتقاها، در کیش همه‌ی حرکات فرار
+		MovePicker picker(m_board, ttMove, &m_mainHistory);
+		Move bestMove = Move::none();
+		int moveCount = 0;
+		while (const Move move = picker.next()) {
+			moveCount++;
+
+			if (!inCheck && bestScore > -VALUE_MATE_IN_MAX_PLY) {
+				// ========== هرس دلتا ==========
+				// حتی بردن مهره‌ی گرفته‌شده با حاشیه‌ی امن به alpha نمی‌رسد
+				if (!move.isPromotion()) {
+					const int futilityValue = futilityBase
+						+ MoveGenerator::SeeValues[static_cast<int>(typeOf(m_board.getCapturedPiece(move)))];
+					if (futilityValue <= alpha) {
+						bestScore = std::max(bestScore, futilityValue);
+						continue;
+					}
+				}
+
+				// گرفتنی که در تبادل مهره از دست می‌دهد وضعیت را آرام‌تر نمی‌کند
+				if (!MoveGenerator::seeGE(m_board, move, 0))
+					continue;
+			}
+
+			m_board.makeMove(move);
+			const int score = -quiescence<nodeType>(ply + 1, -beta, -alpha);
+			m_board.unmakeMove(move);
+
+			if (m_search.stopped())
+				return 0;
+
+			if (score > bestScore) {
+				bestScore = score;
+				if (score > alpha) {
+					bestMove = move;
+					alpha = score;
+					if constexpr (pvNode)
+						updatePv(ply, move);
+					if (alpha >= beta)
+						break;
+				}
+			}
 		}
-		return value;
-	}
-}
-// در Search.cpp  
-void Search::parallel_search(Board& board, int depth, int threads) {
-	std::vector<std::thread> workers;
-	auto moves = board.generate_all_moves();
-
-	for (int i = 0; i < threads; i++) {
-		workers.emplace_back([&, i]() {
-			Board local_board = board;
-			alpha_beta(local_board, depth, -INF, INF, true);
-		});
-	}
-
-	for (auto& thread : workers) thread.join();
-}
-int Search::quiescence(Board& board, int alpha, int beta) {
-	// ارزیابی اولیه موقعیت  
-	int stand_pat = evaluator.evaluate(board);
-	if (stand_pat >= beta) return beta;
-	if (stand_pat > alpha) alpha = stand_pat;
-
-	// تولید حرکات خشن (کیش/گرفتن مهره)  
-	auto captures = board.generate_captures();
-	for (const Move& move : captures) {
-		Board new_board = board;
-		new_board.apply_move(move);
-		int score = -quiescence(new_board, -beta, -alpha);
-		if (score >= beta) return beta;
-		if (score > alpha) alpha = score;
-	}
-
-	// تولید حرکات کیش + گرفتن مهره
-	auto aggressiveMoves = board.generateAggressiveMoves();
-	for (const Move& move : aggressiveMoves) {
-		board.makeMove(move);
-		int score = -quiescence(board, -beta, -alpha);
-		board.unmakeMove(move);
-		auto checks = board.generateChecks(); // اضافه کردن حرکات کیش
-
-		// ...
-	}
-	return alpha;
-	
-}
-
-// در Search.cpp
-Move Search::findBestMoveWithTimeControl(int maxDepth, int maxTimeMs) {
-	auto start = std::chrono::steady_clock::now();
-	Move bestMove;
-	for (int depth = 1; depth <= maxDepth; depth++) {
-		if (std::chrono::duration_cast<std::chrono::milliseconds>(...).count() > maxTimeMs)
-			break;
-		bestMove = alphaBetaRoot(depth);
-	}
-	return bestMove;
-}
-
-// در Search.cpp
-std::atomic<int> bestScore;
-
-void Search::lazySMP(int depth) {
-	
-	bestScore = -INFINITY;
-	std::vector<std::thread> threads;
-	for (int i = 0; i < 4; i++) { // 4 ترد
-		threads.emplace_back([this, depth, i]() {
-			alphaBeta(depth + i, ...); // جستجو با عمق متفاوت
-		});
-	}
-
-	for (auto& t : threads) t.join();
-}
-
-Move Search::findBestMove(Board& board, int depth) {
-	int bestValue = -INFINITY;
-	Move bestMove;
-
-	for (auto& move : board.generateLegalMoves()) {
-		board.makeMove(move);
-		int value = alphaBeta(board, depth - 1, -INFINITY, INFINITY, false);
-		board.undoMove();
-
-		if (value > bestValue) {
-			bestValue = value;
-			bestMove = move;
+
+		if (inCheck && !moveCount)
+			return matedIn(ply);
+
+		TT.store(key, bestMove, scoreToTT(bestScore, ply), staticEval, 0,
+			bestScore >= beta ? Bound::Lower : Bound::Upper);
+		return bestScore;
+	}
+
+	void SearchWorker::updateStats(Move bestMove, int ply, int depth, const Move* quiets, int quietCount) {
+		const int bonus = historyBonus(depth);
+
+		if (m_board.getCapturedPiece(bestMove) == Piece::None && !bestMove.isPromotion()) {
+			SearchStack* ss = stackAt(ply);
+			if (ss->killers[0] != bestMove) {
+				ss->killers[1] = ss->killers[0];
+				ss->killers[0] = bestMove;
+			}
+
+			const Move prevMove = (ss - 1)->currentMove;
+			if (prevMove.isValid())
+				m_counterMoves[static_cast<int>(m_board.getPiece(prevMove.to()))][prevMove.to()] = bestMove;
+
+			updateQuietHistories(bestMove, ply, bonus);
 		}
+
+		for (int i = 0; i < quietCount; ++i)
+			updateQuietHistories(quiets[i], ply, -bonus);
+	}
+
+	void SearchWorker::updateQuietHistories(Move move, int ply, int bonus) {
+		updateHistory(butterfly(m_mainHistory, m_board.getTurn(), move), bonus);
+
+		// جدول ادامه‌ی یک و دو لایه قبل (نه پس از حرکت پوچ)
+		SearchStack* ss = stackAt(ply);
+		const int pc = static_cast<int>(m_board.getPiece(move.from()));
+		for (int back : { 1, 2 })
+			if ((ss - back)->currentMove.isValid())
+				updateHistory((*(ss - back)->contHist)[pc][move.to()], bonus);
+	}
+
+	void SearchWorker::updatePv(int ply, Move move) {
+		m_pv[ply][ply] = move;
+		for (int i = ply + 1; i < m_pvLength[ply + 1]; ++i)
+			m_pv[ply][i] = m_pv[ply + 1][i];
+		m_pvLength[ply] = m_pvLength[ply + 1];
+	}
+
+	bool SearchWorker::onPreviousPv(int ply) {
+		if (ply >= m_rootPvLength)
+			return false;
+		for (int i = 0; i < ply; ++i)
+			if (stackAt(i)->currentMove != m_rootPv[i])
+				return false;
+		return true;
+	}
+
+	// ##### Search #####
+
+	Search::Search() {
+		setThreads(1);
 	}
-	return bestMove;
-}
 
-int Search::alphaBeta(Board& board, int depth, int alpha, int beta, bool maximizingPlayer) {
-	if (depth == 0) return Evaluator::evaluate(board);
+	Search::~Search() {
+		stop();
+		wait();
+	}
+
+	void Search::setThreads(int count) {
+		wait();
+		count = std::clamp(count, 1, MaxThreads);
+		m_workers.clear();
+		for (int i = 0; i < count; i++)
+			m_workers.push_back(std::make_unique<SearchWorker>(*this, i));
+	}
+
+	void Search::clear() {
+		wait();
+		for (auto& w : m_workers)
+			w->clear();
+	}
+
+	// ========== شروع و توقف ==========
+	void Search::start(const Board& board, const SearchLimits& limits) {
+		wait();
+
+		m_limits = limits;
+		m_stop.store(false);
+		m_ponder.store(limits.ponder);
+		m_stopOnPonderhit.store(false);
+		m_result = SearchResult();
+		m_time.init(limits, board.getTurn());
+
+		// با محدودیت گره ساعت زودتر بررسی می‌شود تا از سقف گره زیاد عبور نکند
+		m_pollInterval = limits.nodes
+			? static_cast<int>(std::clamp<uint64_t>(limits.nodes / 1024, 1, 1024))
+			: 1024;
+
+		// شمارنده‌ها پیش از راه‌اندازی تردها صفر می‌شوند تا گزارش ترد اصلی گره‌های کهنه را نشمارد
+		for (auto& w : m_workers) {
+			w->m_nodes.store(0, std::memory_order_relaxed);
+			w->m_pollCountdown = m_pollInterval;
+		}
+
+		m_rootBoard = board;
+		TT.newSearch();
+		m_workers[0]->startSearching();
+	}
+
+	void Search::stop() {
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_stop.store(true);
+		}
+		m_cv.notify_all();
+	}
+
+	void Search::ponderhit() {
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_ponder.store(false);
+			if (m_stopOnPonderhit.load())
+				m_stop.store(true);
+		}
+		m_cv.notify_all();
+	}
+
+	SearchResult Search::wait() {
+		if (!m_workers.empty())
+			m_workers[0]->waitForSearchFinished();
+		return m_result;
+	}
+
+	// ========== ترد اصلی ==========
+	void Search::mainThreadSearch() {
+		if (m_limits.perft) {
+			mainThreadPerft();
+			return;
+		}
+
+		for (size_t i = 1; i < m_workers.size(); i++)
+			m_workers[i]->startSearching();
+		m_workers[0]->iterativeDeepening(m_rootBoard);
+
+		// در حالت ponder یا infinite تا stop یا ponderhit صبر کن، سپس کمک‌ها را متوقف کن
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_cv.wait(lock, [this] { return stopped() || (!m_ponder.load() && !m_limits.infinite); });
+			m_stop.store(true);
+		}
+		for (size_t i = 1; i < m_workers.size(); i++)
+			m_workers[i]->waitForSearchFinished();
+
+		const SearchWorker* best = pickBestWorker();
+		if (best != m_workers[0].get())
+			reportIteration(*best);
+
+		m_result.bestMove = best->m_bestMove;
+		// حتی یک تکرار کامل نشده: اولین حرکت قانونی
+		if (!m_result.bestMove && !best->m_rootMoves.empty())
+			m_result.bestMove = best->m_rootMoves[0];
+		m_result.score = best->m_bestScore;
+		m_result.depth = best->m_completedDepth;
+		m_result.nodes = totalNodes();
+		// حرکت دوم PV؛ اگر PV کوتاه است از جدول انتقال
+		m_result.ponderMove = best->m_rootPvLength > 1 && best->m_rootPv[0] == m_result.bestMove
+			? best->m_rootPv[1]
+			: findPonderMove(m_rootBoard, m_result.bestMove);
+
+		std::string line = "bestmove " + (m_result.bestMove ? m_result.bestMove.toUCI() : "0000");
+		if (m_result.ponderMove)
+			line += " ponder " + m_result.ponderMove.toUCI();
+		output(line);
+	}
+
+	void Search::mainThreadPerft() {
+		PerftOptions options;
+		options.threads = threadCount();
+		options.hashMB = TT.sizeMB();
+		options.stop = &m_stop;
+
+		Board board = m_rootBoard;
+		std::ostringstream divide;
+		m_result.nodes = perftDivide(board, m_limits.perft, divide, options);
+
+		std::string text = divide.str();
+		while (!text.empty() && text.back() == '\n')
+			text.pop_back();
+		output(text);
+	}
+
+	// فقط ترد اصلی صدا می‌زند (هر m_pollInterval گره)؛ سقف سخت زمان حتی وسط تکرار رعایت می‌شود
+	void Search::checkTime() {
+		if (m_limits.nodes && totalNodes() >= m_limits.nodes)
+			m_stop.store(true, std::memory_order_relaxed);
+		if (m_ponder.load(std::memory_order_relaxed))
+			return;
+		if (m_time.enabled() && m_time.elapsed() >= m_time.maximum())
+			m_stop.store(true, std::memory_order_relaxed);
+	}
+
+	int64_t Search::elapsed() const {
+		return m_time.elapsed();
+	}
+
+	uint64_t Search::totalNodes() const {
+		uint64_t nodes = 0;
+		for (const auto& w : m_workers)
+			nodes += w->nodes();
+		return nodes;
+	}
+
+	// ========== انتخاب نتیجه ==========
+	// عمیق‌ترین تکرار کامل‌شده، به شرطی که امتیازش بدتر نباشد؛ در عمق برابر امتیاز بهتر
+	SearchWorker* Search::pickBestWorker() const {
+		SearchWorker* best = m_workers[0].get();
+		for (const auto& w : m_workers) {
+			if (!w->m_completedDepth)
+				continue;
+			if (!best->m_completedDepth
+				|| (w->m_completedDepth > best->m_completedDepth && w->m_bestScore >= best->m_bestScore)
+				|| (w->m_completedDepth == best->m_completedDepth && w->m_bestScore > best->m_bestScore))
+				best = w.get();
+		}
+		return best;
+	}
+
+	// حرکت پیش‌بینی‌شده‌ی حریف از جدول انتقال (در صورت قانونی بودن)
+	Move Search::findPonderMove(const Board& board, Move bestMove) const {
+		if (!bestMove)
+			return Move::none();
+
+		Board next = board;
+		next.makeMove(bestMove);
+		TTData tt;
+		if (!TT.probe(next.getZobristKey(), tt) || !tt.move)
+			return Move::none();
+
+		MoveList moves;
+		MoveGenerator::generateLegalMoves(next, moves);
+		return moves.contains(tt.move) ? tt.move : Move::none();
+	}
+
+	void Search::reportIteration(const SearchWorker& worker) const {
+		if (!m_out)
+			return;
+		const int64_t ms = elapsed();
+		const uint64_t nodes = totalNodes();
+		std::ostringstream info;
+		info << "info depth " << worker.m_completedDepth
+			<< " score " << UciScore{ worker.m_bestScore }
+			<< " nodes " << nodes
+			<< " nps " << nodes * 1000 / static_cast<uint64_t>(std::max<int64_t>(ms, 1))
+			<< " hashfull " << TT.hashfull()
+			<< " time " << ms
+			<< " pv";
+		for (int i = 0; i < worker.m_rootPvLength; ++i)
+			info << ' ' << worker.m_rootPv[i].toUCI();
+		output(info.str());
+	}
+
+	void Search::output(const std::string& line) const {
+		if (!m_out)
+			return;
+		std::lock_guard<std::mutex> lock(m_outMutex);
+		*m_out << line << std::endl;
+	}
 
-	// ... (پیاده‌سازی کامل آلفا-بتا)
-}
\ No newline at end of file
+} // namespace ChessEngine
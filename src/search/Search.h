@@ -1,131 +1,228 @@
-﻿
-// src/search/Search.h
+﻿// src/search/Search.h
 #pragma once
-#include "../board/Board.h"
-#include "../evaluation/Evaluator.h"
-#include "Board.h"  
-
-
-class Search {
-		public:
-			static Move findBestMove(Board& board, int depth);
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../Core/Board.h"
+#include "../movegen/MoveList.h"
+#include "../../evaluation/Evaluator.h"
+#include "History.h"
+#include "TimeManager.h"
+
+namespace ChessEngine {
+
+	// ========== ثابت‌های امتیاز ==========
+	constexpr int MAX_PLY = 128;
+	constexpr int MaxThreads = 1024;
+
+	constexpr int VALUE_DRAW = 0;
+	constexpr int VALUE_MATE = 32000;
+	constexpr int VALUE_INFINITE = 32001;
+	constexpr int VALUE_NONE = 32002;
+	constexpr int VALUE_MATE_IN_MAX_PLY = VALUE_MATE - MAX_PLY;
+
+	constexpr int mateIn(int ply) { return VALUE_MATE - ply; }
+	constexpr int matedIn(int ply) { return -VALUE_MATE + ply; }
+
+	// محدودیت‌های دستور go (زمان‌ها به میلی‌ثانیه، صفر یعنی نامحدود)
+	struct SearchLimits {
+		int depth = MAX_PLY - 1;
+		uint64_t nodes = 0;
+		int64_t moveTime = 0;
+		int64_t time[2] = { 0, 0 };
+		int64_t inc[2] = { 0, 0 };
+		int movesToGo = 0;
+		bool infinite = false;
+		bool ponder = false;
+		// go perft N: به جای جستجو، شمارش divide تا این عمق (صفر: جستجوی عادی)
+		int perft = 0;
+	};
 
-		private:
-			static int alphaBeta(Board& board, int depth, int alpha, int beta, bool maximizing);
-			static int quiescenceSearch(Board& board, int alpha, int beta);
-	
-public:
-	static Move findBestMove(Board& board, int depth);
+	struct SearchResult {
+		Move bestMove = Move::none();
+		Move ponderMove = Move::none();
+		int score = 0;
+		int depth = 0;
+		uint64_t nodes = 0;
+	};
 
-private:
-	static int alphaBeta(Board& board, int depth, int alpha, int beta, bool maximizingPlayer);
-	static int quiescenceSearch(Board& board, int alpha, int beta);
+	class Search;
+
+	// قاب پشته‌ی جستجو برای یک لایه. پشته یک بار برای هر ترد تخصیص می‌یابد
+	// و در حین جستجو هیچ تخصیص حافظه‌ای انجام نمی‌شود.
+	struct SearchStack {
+		// جدول ادامه‌ی حرکت این لایه (برای امتیازدهی حرکات لایه‌های بعد)
+		PieceToHistory* contHist = nullptr;
+		// حرکت در حال جستجو (Move::null() برای حرکت پوچ)
+		Move currentMove = Move::none();
+		// حرکتی که در این لایه جستجو نمی‌شود (برای جستجوی تکین)
+		Move excludedMove = Move::none();
+		std::array<Move, 2> killers{};
+		// ارزیابی ایستا (VALUE_NONE در کیش) برای تشخیص بهبود موقعیت
+		int staticEval = VALUE_NONE;
+		bool inCheck = false;
+	};
 
-public:
-	int history[64][64]; // [from][to] تاریخچه حرکات موفق
-	struct SearchResult {
-		Move bestMove;
-		int score;
-		int nodesVisited;
+	// وضعیت خصوصی یک ترد جستجو: کپی صفحه (با پشته‌ی وضعیت خودش)، جداول killer/history،
+	// جدول پیاده‌ی ارزیاب و نتیجه‌ی آخرین تکرار کامل. تنها داده‌ی مشترک بین تردها جدول انتقال است.
+	// هر کارگر ترد دائمی خودش را دارد که بین جستجوها خواب است؛ شروع جستجو
+	// فقط یک بیدارباش است و هزینه‌ی ساخت ترد ندارد.
+	class SearchWorker {
+	public:
+		SearchWorker(Search& search, int index);
+		~SearchWorker();
+		SearchWorker(const SearchWorker&) = delete;
+		SearchWorker& operator=(const SearchWorker&) = delete;
+
+		// بیدار کردن ترد برای یک جستجو / انتظار تا برگشتن آن به حالت خواب
+		void startSearching();
+		void waitForSearchFinished();
+
+		// عمیق‌سازی تدریجی روی کپی صفحه تا توقف یا رسیدن به عمق مجاز
+		void iterativeDeepening(const Board& rootBoard);
+		void clear();
+
+		bool isMainThread() const { return m_index == 0; }
+		uint64_t nodes() const { return m_nodes.load(std::memory_order_relaxed); }
+
+	private:
+		friend class Search;
+
+		// نوع گره: ریشه، واریانت اصلی (پنجره‌ی باز) یا پنجره‌ی تهی
+		enum NodeType { NonPV, PV, Root };
+
+		template <NodeType nodeType>
+		int search(int depth, int ply, int alpha, int beta);
+		template <NodeType nodeType>
+		int quiescence(int ply, int alpha, int beta);
+
+		// به‌روزرسانی killer، countermove و historyها پس از برش بتا؛
+		// حرکات آرام قبلی که برش نخوردند جریمه می‌شوند
+		void updateStats(Move bestMove, int ply, int depth, const Move* quiets, int quietCount);
+		void updateQuietHistories(Move move, int ply, int bonus);
+
+		// دو قاب نگهبان پیش از ریشه تا (ss - 1) و (ss - 2) همیشه معتبر باشند
+		static constexpr int StackOffset = 2;
+		SearchStack* stackAt(int ply) { return &m_stack[ply + StackOffset]; }
+
+		// PV مثلثی: m_pv[ply][ply..m_pvLength[ply]) بهترین ادامه از این لایه است
+		void updatePv(int ply, Move move);
+		// آیا مسیر فعلی از ریشه تا ply همان PV تکرار قبل است
+		bool onPreviousPv(int ply);
+
+		void countNode();
+
+		// تردهای کمکی بعضی عمق‌ها را رد می‌کنند تا روی عمق‌های متفاوت پخش شوند
+		bool skipDepth(int depth) const;
+
+		// حلقه‌ی ترد دائمی: انتظار برای startSearching، اجرای جستجو، تکرار تا نابودی
+		void idleLoop();
+
+		Search& m_search;
+		const int m_index;
+		Board m_board;
+
+		MoveList m_rootMoves;
+		Evaluator m_evaluator;
+		ButterflyHistory m_mainHistory;
+		ContinuationHistory m_continuationHistory;
+		CounterMoveHistory m_counterMoves;
+
+		std::array<SearchStack, MAX_PLY + StackOffset + 1> m_stack;
+		std::array<std::array<Move, MAX_PLY + 1>, MAX_PLY + 1> m_pv;
+		std::array<int, MAX_PLY + 1> m_pvLength;
+		// PV آخرین تکرار کامل (برای گزارش و ترتیب حرکات تکرار بعد)
+		std::array<Move, MAX_PLY> m_rootPv;
+		int m_rootPvLength = 0;
+
+		// جستجوی تأییدی حرکت پوچ: تا این لایه، حرکت پوچ برای m_nmpColor ممنوع است
+		int m_nmpMinPly = 0;
+		Color m_nmpColor = Color::White;
+
+		std::atomic<uint64_t> m_nodes{ 0 };
+		// ترد اصلی: گره‌های باقی‌مانده تا بررسی بعدی ساعت
+		int m_pollCountdown = 0;
+		// مدیریت زمان (فقط ترد اصلی): تغییرات بهترین حرکت ریشه با میرایی بین تکرارها
+		double m_bestMoveChanges = 0;
+		int m_completedDepth = 0;
+		int m_bestScore = -VALUE_INFINITE;
+		Move m_bestMove = Move::none();
+
+		std::mutex m_threadMutex;
+		std::condition_variable m_threadCv;
+		bool m_searching = true;
+		bool m_exit = false;
+		std::thread m_thread;
 	};
-	// در Search.h  
-	int alpha_beta(Board& board, int depth, int alpha, int beta, bool maximizing_player);
-	Search(Board& board, Evaluator& evaluator);
-
-	SearchResult startSearch(int depth);
-
-	SearchResult iterativeDeepeningSearch(int maxDepth, int timeLimit) {
-		SearchResult finalResult;
-		auto start = std::chrono::high_resolution_clock::now();
-
-		for (int depth = 1; depth <= maxDepth; depth++) {
-			auto currentResult = startSearch(depth);
-
-			auto elapsed = std::chrono::high_resolution_clock::now() - start;
-			if (std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count() > timeLimit)
-				break;
-
-			finalResult = currentResult;
-		}
-		return finalResult;
-	}
-	void orderMoves(std::vector<Move>& moves, const Board& board) {
-		std::sort(moves.begin(), moves.end(), [&](const Move& a, const Move& b) {
-			return board.getCapturedPiece(a) > board.getCapturedPiece(b);
-		});
-	}
-	// در کلاس Search
-	void orderMoves(std::vector<Move>& moves, const Board& board) {
-		std::sort(moves.begin(), moves.end(), [&](const Move& a, const Move& b) {
-			// اولویت ۱: حرکات تاکتیکی (کشتن مهره باارزشتر)
-			int aCaptureValue = board.getPieceValue(a.getCapturedPiece());
-			int bCaptureValue = board.getPieceValue(b.getCapturedPiece());
-
-			// اولویت ۲: حرکات Killer (حرکاتی که قبلاً باعث برش بتا شدند)
-			bool aIsKiller = (a == killerMoves[board.getPly()][0] || a == killerMoves[board.getPly()][1]);
-			bool bIsKiller = (b == killerMoves[board.getPly()][0] || b == killerMoves[board.getPly()][1]);
-
-			return (aCaptureValue > bCaptureValue) || (aIsKiller && !bIsKiller);
-		});
-	}
-private:
-	Board& currentBoard;
-	Evaluator& evaluator;
-
-	int alphaBeta(Board& board, int depth, int alpha, int beta, bool maximizingPlayer);
-};
-
-// در Search.h  
-
-struct TranspositionTableEntry {
-	uint64_t hash;
-	int score;
-	int depth;
-	enum Flag { EXACT, LOWER_BOUND, UPPER_BOUND } flag;
-};
-
-
-class TranspositionTable {
-private:
-	std::unordered_map<uint64_t, TranspositionEntry> table;
-	std::shared_mutex mutex;
-	std::unordered_map<uint64_t, TTEntry> table;
-public:
-	struct Entry { uint64_t key; int score; int depth; };
-	std::unordered_map<uint64_t, Entry> table;
-	struct Entry {
-		uint64_t key;
-		int score;
-		int depth;
-		// ...
+
+	// کنترل جستجوی موازی Lazy SMP: همه‌ی تردها همان ریشه را مستقل جستجو می‌کنند
+	// و فقط از طریق جدول انتقال بدون قفل به هم کمک می‌کنند. ترد اصلی زمان را
+	// کنترل می‌کند و پس از توقف بهترین تکرار کامل‌شده را بین همه‌ی تردها انتخاب می‌کند.
+	class Search {
+	public:
+		Search();
+		~Search();
+		Search(const Search&) = delete;
+		Search& operator=(const Search&) = delete;
+
+		// تغییر تعداد تردها (منتظر پایان جستجوی جاری می‌ماند)
+		void setThreads(int count);
+		int threadCount() const { return static_cast<int>(m_workers.size()); }
+
+		// خط‌های info و bestmove در این جریان نوشته می‌شوند (nullptr: بدون خروجی)
+		void setOutput(std::ostream* out) { m_out = out; }
+		// نوشتن یک خط کامل بدون درهم‌ریختگی با خروجی ترد جستجو (مثلاً readyok)
+		void output(const std::string& line) const;
+
+		// شروع جستجو در پس‌زمینه؛ بلافاصله برمی‌گردد
+		void start(const Board& board, const SearchLimits& limits);
+		// توقف فوری؛ bestmove همچنان توسط ترد اصلی گزارش می‌شود
+		void stop();
+		// حریف حرکت پیش‌بینی‌شده را بازی کرد: ادامه با مدیریت زمان عادی
+		void ponderhit();
+		// منتظر پایان جستجو و بازگرداندن نتیجه
+		SearchResult wait();
+
+		bool stopped() const { return m_stop.load(std::memory_order_relaxed); }
+		// پاک کردن جداول تاریخچه‌ی همه‌ی تردها (ucinewgame)
+		void clear();
+
+	private:
+		friend class SearchWorker;
+		void mainThreadSearch();
+		// perft روی ترد اصلی با تعداد تردها و اندازه‌ی هش فعلی؛ با stop متوقف می‌شود
+		void mainThreadPerft();
+		void checkTime();
+		int64_t elapsed() const;
+		uint64_t totalNodes() const;
+		SearchWorker* pickBestWorker() const;
+		Move findPonderMove(const Board& board, Move bestMove) const;
+		void reportIteration(const SearchWorker& worker) const;
+
+		std::vector<std::unique_ptr<SearchWorker>> m_workers;
+		Board m_rootBoard;
+
+		std::atomic<bool> m_stop{ false };
+		std::atomic<bool> m_ponder{ false };
+		// زمان هدف در حین ponder تمام شد: با ponderhit بلافاصله متوقف شو
+		std::atomic<bool> m_stopOnPonderhit{ false };
+		std::mutex m_mutex;
+		std::condition_variable m_cv;
+
+		SearchLimits m_limits;
+		TimeManager m_time;
+		// فاصله‌ی بررسی ساعت و محدودیت گره (بر حسب گره‌های ترد اصلی)
+		int m_pollInterval = 1024;
+		SearchResult m_result;
+		std::ostream* m_out = nullptr;
+		mutable std::mutex m_outMutex;
 	};
-	std::unordered_map<uint64_t, Entry> table;
-
-	void store(uint64_t key, int score, int depth) { /*...*/ }
-	Entry* probe(uint64_t key) { /*...*/ }
-
-	void save(uint64_t hash, const TranspositionTableEntry& entry);
-	std::optional<TranspositionTableEntry> probe(uint64_t hash);
-	int quiescence(...) {
-		int standPat = evaluate();
-		if (standPat >= beta) return beta;
-		// ...
-	}
-	void store(uint64_t hash, int score, int depth, TranspositionEntry::Flag flag) {
-		std::unique_lock lock(mutex);
-		table[hash] = { hash, score, depth, flag };
-	}
-
-	TranspositionEntry probe(uint64_t hash) {
-		std::shared_lock lock(mutex);
-		return table.count(hash) ? table[hash] : TranspositionEntry{ 0, 0, 0, TranspositionEntry::EXACT };
-	}
-
-private:
-	std::unordered_map<uint64_t, TranspositionTableEntry> table;
-};
-struct SearchResult {
-	Move best_move;
-	int score;
-};
-SearchResult minimax(Board board, int depth);
\ No newline at end of file
+
+} // namespace ChessEngine
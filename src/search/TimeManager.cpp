@@ -0,0 +1,59 @@
+// src/search/TimeManager.cpp
+#include "TimeManager.h"
+#include "Search.h"
+#include <algorithm>
+
+namespace ChessEngine {
+
+	namespace {
+		// حاشیه‌ی امن برای تأخیر ارتباط با رابط گرافیکی در هر حرکت
+		constexpr int64_t MoveOverhead = 30;
+		// وقتی movestogo داده نشده زمان تا این تعداد حرکت پخش می‌شود
+		constexpr int MovesHorizon = 50;
+		// سقف سخت حداکثر چند برابر زمان هدف است
+		constexpr int MaxRatio = 5;
+	}
+
+	void TimeManager::init(const SearchLimits& limits, Color us) {
+		m_startTime = Clock::now();
+		m_optimum = m_maximum = 0;
+		m_fixed = false;
+		if (limits.infinite)
+			return;
+
+		if (limits.moveTime) {
+			m_fixed = true;
+			m_optimum = m_maximum = std::max<int64_t>(1, limits.moveTime - MoveOverhead);
+			return;
+		}
+
+		const int64_t time = limits.time[static_cast<int>(us)];
+		const int64_t inc = limits.inc[static_cast<int>(us)];
+		if (!time)
+			return;
+
+		// تأخیر فقط برای همین حرکت کم می‌شود و با ساعت بسیار کم تا ۱۰٪ آن کوچک می‌شود
+		const int64_t overhead = std::min<int64_t>(MoveOverhead, time / 10);
+
+		// زمان قابل استفاده تا افق: باقی‌مانده به‌علاوه‌ی افزایش‌های آینده منهای تأخیر
+		const int mtg = limits.movesToGo ? std::min(limits.movesToGo, MovesHorizon) : MovesHorizon;
+		const int64_t timeLeft = std::max<int64_t>(1, time + inc * (mtg - 1) - overhead);
+
+		m_optimum = timeLeft / mtg;
+		// هرگز بیش از ۸۰٪ ساعت باقی‌مانده در یک حرکت مصرف نمی‌شود
+		m_maximum = std::min<int64_t>(m_optimum * MaxRatio, time * 8 / 10 - overhead);
+		m_maximum = std::max<int64_t>(1, m_maximum);
+		m_optimum = std::clamp<int64_t>(m_optimum, 1, m_maximum);
+	}
+
+	double TimeManager::scale(int stableIterations, double bestMoveChanges, int scoreDrop) {
+		// بهترین حرکت پایدار: تا ۳۰٪ کمتر از زمان هدف
+		const double stability = 1.2 - 0.1 * std::min(stableIterations, 5);
+		// هر تغییر بهترین حرکت زمان بیشتری می‌خواهد
+		const double instability = 1.0 + 0.5 * bestMoveChanges;
+		// افت امتیاز: تا ۵۰٪ بیشتر؛ بهبود امتیاز: تا ۲۰٪ کمتر
+		const double falling = std::clamp(1.0 + scoreDrop / 200.0, 0.8, 1.5);
+		return stability * instability * falling;
+	}
+
+} // namespace ChessEngine
@@ -0,0 +1,45 @@
+// src/search/TimeManager.h
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include "../Core/Types.h"
+
+namespace ChessEngine {
+
+	struct SearchLimits;
+
+	// بودجه‌ی زمانی یک حرکت (میلی‌ثانیه)
+	//   optimum: زمان هدف؛ پس از هر تکرار کامل با پایداری بهترین حرکت مقیاس می‌شود
+	//   maximum: سقف سخت؛ جستجو وسط تکرار هم در این لحظه متوقف می‌شود
+	class TimeManager {
+	public:
+		using Clock = std::chrono::steady_clock;
+
+		// شروع ساعت و محاسبه‌ی بودجه از پارامترهای go
+		void init(const SearchLimits& limits, Color us);
+
+		int64_t elapsed() const {
+			return std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - m_startTime).count();
+		}
+
+		// آیا محدودیت زمانی فعال است (بدون movetime/wtime/btime: فقط عمق، گره یا infinite)
+		bool enabled() const { return m_maximum != 0; }
+		// movetime ثابت است و با پایداری کوتاه یا بلند نمی‌شود
+		bool fixedTime() const { return m_fixed; }
+		int64_t optimum() const { return m_optimum; }
+		int64_t maximum() const { return m_maximum; }
+
+		// ضریب زمان هدف پس از یک تکرار کامل:
+		//   stableIterations: تعداد تکرارهای پیاپی با همان بهترین حرکت
+		//   bestMoveChanges: تغییرات بهترین حرکت ریشه (با میرایی بین تکرارها)
+		//   scoreDrop: افت امتیاز نسبت به میانگین تکرارهای قبل (سانتی‌پیاده)
+		static double scale(int stableIterations, double bestMoveChanges, int scoreDrop);
+
+	private:
+		Clock::time_point m_startTime;
+		int64_t m_optimum = 0;
+		int64_t m_maximum = 0;
+		bool m_fixed = false;
+	};
+
+} // namespace ChessEngine
@@ -0,0 +1,167 @@
+// src/search/TranspositionTable.cpp
+#include "TranspositionTable.h"
+#include <algorithm>
+#include <climits>
+#include <new>
+
+#if defined(_MSC_VER)
+#include <xmmintrin.h>
+#endif
+
+namespace ChessEngine {
+
+	TranspositionTable TT;
+
+	TranspositionTable::TranspositionTable() {
+		resize(DefaultSizeMB);
+	}
+
+	TranspositionTable::~TranspositionTable() {
+		delete[] m_buckets;
+	}
+
+	// ========== تخصیص حافظه ==========
+	size_t TranspositionTable::bucketCountFor(size_t megabytes) {
+		// بزرگ‌ترین توان دو که در حافظه‌ی درخواستی جا می‌شود
+		size_t bucketCount = 1;
+		while (bucketCount * 2 * sizeof(Bucket) <= megabytes * 1024 * 1024)
+			bucketCount *= 2;
+		return bucketCount;
+	}
+
+	bool TranspositionTable::resize(size_t megabytes) {
+		megabytes = std::clamp<size_t>(megabytes, 1, MaxSizeMB);
+		size_t bucketCount = bucketCountFor(megabytes);
+		bool allocated = true;
+
+		if (bucketCount != m_bucketCount) {
+			Bucket* buckets = new (std::nothrow) Bucket[bucketCount];
+			if (!buckets) {
+				allocated = false;
+				// جدول قبلی (پاک‌شده) می‌ماند؛ اگر نبود، اندازه‌ی پیش‌فرض
+				if (m_buckets) {
+					clear();
+					return false;
+				}
+				megabytes = DefaultSizeMB;
+				bucketCount = bucketCountFor(megabytes);
+				buckets = new Bucket[bucketCount];
+			}
+			delete[] m_buckets;
+			m_buckets = buckets;
+			m_bucketCount = bucketCount;
+		}
+		m_sizeMB = megabytes;
+		clear();
+		return allocated;
+	}
+
+	void TranspositionTable::clear() {
+		for (size_t i = 0; i < m_bucketCount; i++) {
+			for (Entry& e : m_buckets[i].entries) {
+				e.check.store(0, std::memory_order_relaxed);
+				e.data.store(0, std::memory_order_relaxed);
+			}
+		}
+		m_generation = 0;
+	}
+
+	// ========== بسته‌بندی ورودی ==========
+	uint64_t TranspositionTable::pack(Move move, int score, int eval, int depth, Bound bound, uint8_t generation) {
+		return static_cast<uint64_t>(move.raw())
+			| static_cast<uint64_t>(static_cast<uint16_t>(score)) << 16
+			| static_cast<uint64_t>(static_cast<uint16_t>(eval)) << 32
+			| static_cast<uint64_t>(static_cast<uint8_t>(depth)) << 48
+			| static_cast<uint64_t>(bound) << 56
+			| static_cast<uint64_t>(generation & GenerationMask) << 58;
+	}
+
+	TTData TranspositionTable::unpack(uint64_t data) {
+		TTData d;
+		d.move = Move(static_cast<uint16_t>(data));
+		d.score = static_cast<int16_t>(data >> 16);
+		d.eval = static_cast<int16_t>(data >> 32);
+		d.depth = static_cast<int8_t>(data >> 48);
+		d.bound = static_cast<Bound>((data >> 56) & 3);
+		return d;
+	}
+
+	// ========== جستجو در جدول ==========
+	bool TranspositionTable::probe(uint64_t key, TTData& out) const {
+		const Bucket& bucket = bucketFor(key);
+		for (const Entry& e : bucket.entries) {
+			uint64_t data = e.data.load(std::memory_order_relaxed);
+			uint64_t check = e.check.load(std::memory_order_relaxed);
+			if ((check ^ data) == key && data != 0) {
+				out = unpack(data);
+				return true;
+			}
+		}
+		return false;
+	}
+
+	// ========== ذخیره با سیاست جایگزینی عمق/سن ==========
+	void TranspositionTable::store(uint64_t key, Move move, int score, int eval, int depth, Bound bound) {
+		Bucket& bucket = bucketFor(key);
+		Entry* victim = nullptr;
+		int victimValue = INT_MAX;
+
+		for (Entry& e : bucket.entries) {
+			uint64_t data = e.data.load(std::memory_order_relaxed);
+			uint64_t check = e.check.load(std::memory_order_relaxed);
+
+			// همان موقعیت: حرکت قبلی را حفظ کن و ورودی عمیق‌تر را بی‌دلیل بازنویسی نکن
+			if ((check ^ data) == key && data != 0) {
+				if (move == Move::none())
+					move = Move(static_cast<uint16_t>(data));
+				if (bound != Bound::Exact
+					&& depth + 4 <= depthOf(data)
+					&& generationOf(data) == m_generation)
+					return;
+				victim = &e;
+				break;
+			}
+
+			// ورودی خالی بهترین گزینه است
+			if (data == 0 && check == 0) {
+				victim = &e;
+				victimValue = INT_MIN;
+				continue;
+			}
+
+			// ورودی‌های کم‌عمق و قدیمی زودتر جایگزین می‌شوند
+			int age = (m_generation - generationOf(data)) & GenerationMask;
+			int value = depthOf(data) - 8 * age;
+			if (value < victimValue) {
+				victimValue = value;
+				victim = &e;
+			}
+		}
+
+		uint64_t data = pack(move, score, eval, depth, bound, m_generation);
+		victim->data.store(data, std::memory_order_relaxed);
+		victim->check.store(key ^ data, std::memory_order_relaxed);
+	}
+
+	void TranspositionTable::prefetch(uint64_t key) const {
+#if defined(_MSC_VER)
+		_mm_prefetch(reinterpret_cast<const char*>(&bucketFor(key)), _MM_HINT_T0);
+#else
+		__builtin_prefetch(&bucketFor(key));
+#endif
+	}
+
+	int TranspositionTable::hashfull() const {
+		size_t samples = std::min<size_t>(1000, m_bucketCount);
+		int used = 0;
+		for (size_t i = 0; i < samples; i++) {
+			for (const Entry& e : m_buckets[i].entries) {
+				uint64_t data = e.data.load(std::memory_order_relaxed);
+				if (data != 0 && generationOf(data) == m_generation)
+					used++;
+			}
+		}
+		return samples ? static_cast<int>(used * 1000 / (samples * EntriesPerBucket)) : 0;
+	}
+
+} // namespace ChessEngine
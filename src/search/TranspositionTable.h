@@ -0,0 +1,90 @@
+// src/search/TranspositionTable.h
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include "../Core/Move.h"
+
+namespace ChessEngine {
+
+	// نوع کران امتیاز ذخیره‌شده
+	enum class Bound : uint8_t { None = 0, Upper = 1, Lower = 2, Exact = 3 };
+
+	// داده‌ی بازشده‌ی یک ورودی جدول انتقال
+	struct TTData {
+		Move move = Move::none();
+		int16_t score = 0;
+		int16_t eval = 0;
+		int8_t depth = 0;
+		Bound bound = Bound::None;
+	};
+
+	// جدول انتقال با اندازه‌ی ثابت، توان دو و بدون قفل
+	// هر سطل ۶۴ بایت (یک خط کش) و شامل ۴ ورودی است.
+	// هر ورودی دو کلمه‌ی ۶۴ بیتی دارد: data و (key ^ data).
+	// اگر نوشتن دو ترد هم‌زمان شود، XOR دو کلمه دیگر با کلید برابر نیست
+	// و ورودی خراب به‌سادگی نادیده گرفته می‌شود.
+	class TranspositionTable {
+	public:
+		static constexpr size_t DefaultSizeMB = 16;
+		static constexpr size_t MaxSizeMB = 65536;
+
+		// با اندازه‌ی پیش‌فرض تخصیص می‌یابد تا جدول هرگز بدون سطل نباشد
+		TranspositionTable();
+		~TranspositionTable();
+		TranspositionTable(const TranspositionTable&) = delete;
+		TranspositionTable& operator=(const TranspositionTable&) = delete;
+
+		// تخصیص دوباره (فقط وقتی جستجو در جریان نیست). اگر حافظه‌ی درخواستی در دسترس
+		// نباشد false برمی‌گرداند و اندازه‌ی قبلی (یا پیش‌فرض) می‌ماند؛ sizeMB اندازه‌ی واقعی است
+		bool resize(size_t megabytes);
+		void clear();
+
+		// شروع جستجوی جدید: افزایش سن ورودی‌ها
+		void newSearch() { m_generation = (m_generation + 1) & GenerationMask; }
+
+		bool probe(uint64_t key, TTData& out) const;
+		void store(uint64_t key, Move move, int score, int eval, int depth, Bound bound);
+
+		void prefetch(uint64_t key) const;
+
+		// درصد پرشدگی به هزارم (برای info hashfull)
+		int hashfull() const;
+		size_t sizeMB() const { return m_sizeMB; }
+
+	private:
+		struct Entry {
+			std::atomic<uint64_t> check; // key ^ data
+			std::atomic<uint64_t> data;
+		};
+
+		static constexpr int EntriesPerBucket = 4;
+		static constexpr uint8_t GenerationMask = 0x3F;
+
+		struct alignas(64) Bucket {
+			Entry entries[EntriesPerBucket];
+		};
+		static_assert(sizeof(Bucket) == 64, "Bucket must fill exactly one cache line");
+
+		// چیدمان بیتی data:
+		// [0..15] حرکت | [16..31] امتیاز | [32..47] ارزیابی ایستا
+		// [48..55] عمق | [56..57] کران | [58..63] سن
+		static size_t bucketCountFor(size_t megabytes);
+
+		static uint64_t pack(Move move, int score, int eval, int depth, Bound bound, uint8_t generation);
+		static TTData unpack(uint64_t data);
+		static int depthOf(uint64_t data) { return static_cast<int8_t>(data >> 48); }
+		static uint8_t generationOf(uint64_t data) { return static_cast<uint8_t>(data >> 58); }
+
+		Bucket& bucketFor(uint64_t key) const { return m_buckets[key & (m_bucketCount - 1)]; }
+
+		Bucket* m_buckets = nullptr;
+		size_t m_bucketCount = 0;
+		size_t m_sizeMB = 0;
+		uint8_t m_generation = 0;
+	};
+
+	// جدول مشترک بین همه‌ی تردهای جستجو
+	extern TranspositionTable TT;
+
+} // namespace ChessEngine
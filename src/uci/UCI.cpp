@@ -1,22 +1,170 @@
-﻿void UCIHandler::processPosition(const std::string& command) {
-	// پارس کردن وضعیت و اعمال حرکات
+﻿#include "UCI.h"
+#include "../movegen/MoveGenerator.h"
+#include <algorithm>
+#include <iostream>
+#include <sstream>
+
+// تبدیل نماد UCI (مثل e2e4 یا e7e8q) به حرکت فشرده با مقایسه با حرکات قانونی
+static ChessEngine::Move parseMove(ChessEngine::Board& board, const std::string& str) {
+	ChessEngine::MoveList moves;
+	ChessEngine::MoveGenerator::generateLegalMoves(board, moves);
+	for (const auto& m : moves) {
+		if (m.toUCI() == str) return m;
+	}
+	return ChessEngine::Move::none();
+}
+
+UCIHandler::UCIHandler() {
+	search.setOutput(&std::cout);
+}
+
+void UCIHandler::loop() {
+	std::string command;
+	while (std::getline(std::cin, command) && command != "quit")
+		processCommand(command);
+	stopSearch();
+}
+
+// جستجوی infinite/ponder خودش تمام نمی‌شود و فقط همین ترد می‌تواند stop را برساند؛
+// پس دستوری که به جستجوی آزاد نیاز دارد به جای انتظار، اول آن را متوقف می‌کند
+void UCIHandler::stopSearch() {
+	search.stop();
+	search.wait();
+}
+
+void UCIHandler::processCommand(const std::string& command) {
+	std::istringstream iss(command);
+	std::string token;
+	iss >> token;
+
+	if (token == "uci") {
+		std::cout << "id name MyEngine\n";
+		std::cout << "id author YourName\n";
+		printOptions();
+		std::cout << "uciok" << std::endl;
+	}
+	else if (token == "isready") {
+		// حتی در حین جستجو فوراً پاسخ داده می‌شود
+		search.output("readyok");
+	}
+	else if (token == "stop") {
+		search.stop();
+	}
+	else if (token == "ponderhit") {
+		search.ponderhit();
+	}
+	else if (token == "setoption") {
+		stopSearch();
+		processSetOption(command);
+	}
+	else if (token == "ucinewgame") {
+		stopSearch();
+		search.clear();
+		ChessEngine::TT.clear();
+	}
+	else if (token == "position") {
+		stopSearch();
+		processPosition(command);
+	}
+	else if (token == "go") {
+		stopSearch();
+		processGo(command);
+	}
+	else if (token == "d") {
+		board.print();
+	}
+}
+
+// مثال: position startpos moves e2e4 e7e5
+//       position fen <FEN> moves ...
+void UCIHandler::processPosition(const std::string& command) {
+	std::istringstream iss(command);
+	std::string token, fen;
+	iss >> token >> token; // position startpos|fen
+
+	if (token == "startpos") {
+		fen = ChessEngine::StartFEN;
+		iss >> token; // moves
+	}
+	else if (token == "fen") {
+		while (iss >> token && token != "moves")
+			fen += token + " ";
+	}
+	else {
+		return;
+	}
+
+	board.setFromFEN(fen);
+	while (iss >> token) {
+		ChessEngine::Move m = parseMove(board, token);
+		if (!m) break;
+		board.makeMove(m);
+		board.compactHistory();
+	}
 }
 
 void UCIHandler::processGo(const std::string& command) {
-	// شروع جستجو و بازگرداندن بهترین حرکت
-}
-// در UCI.cpp  
-void UCIHandler::process_command(const std::string& cmd) {
-	if (cmd.starts_with("position")) {
-		size_t start = cmd.find("moves");
-		if (start != std::string::npos) {
-			std::string moves_str = cmd.substr(start + 6);
-			std::istringstream iss(moves_str);
-			std::string move;
-			while (iss >> move) {
-				// تبدیل حرکت رشته‌ای به مختصات (مثلاً e2e4 به [6,4] -> [4,4])  
-				// اعمال حرکت روی تخته  
-			}
-		}
-	}
-}
\ No newline at end of file
+	std::istringstream iss(command);
+	std::string token;
+	iss >> token; // go
+
+	// go perft N: شمارش گره‌ها با خروجی divide، در پس‌زمینه و با تنظیمات Threads/Hash
+	ChessEngine::SearchLimits limits;
+	if (iss >> token && token == "perft") {
+		int depth = 1;
+		iss >> depth;
+		limits.perft = std::clamp(depth, 1, ChessEngine::MAX_PLY - 1);
+		search.start(board, limits);
+		return;
+	}
+
+	// go [depth N] [nodes N] [movetime MS] [wtime MS btime MS winc MS binc MS movestogo N] [infinite] [ponder]
+	do {
+		if (token == "depth") iss >> limits.depth;
+		else if (token == "nodes") iss >> limits.nodes;
+		else if (token == "movetime") iss >> limits.moveTime;
+		else if (token == "wtime") iss >> limits.time[0];
+		else if (token == "btime") iss >> limits.time[1];
+		else if (token == "winc") iss >> limits.inc[0];
+		else if (token == "binc") iss >> limits.inc[1];
+		else if (token == "movestogo") iss >> limits.movesToGo;
+		else if (token == "infinite") limits.infinite = true;
+		else if (token == "ponder") limits.ponder = true;
+	} while (iss >> token);
+	limits.depth = std::clamp(limits.depth, 1, ChessEngine::MAX_PLY - 1);
+
+	// شروع جستجو در پس‌زمینه؛ bestmove توسط ترد جستجو چاپ می‌شود
+	search.start(board, limits);
+}
+
+void UCIHandler::printOptions() {
+	std::cout << "option name Hash type spin default " << ChessEngine::TranspositionTable::DefaultSizeMB
+		<< " min 1 max " << ChessEngine::TranspositionTable::MaxSizeMB << "\n";
+	std::cout << "option name Threads type spin default 1 min 1 max " << ChessEngine::MaxThreads << "\n";
+}
+
+// مثال: setoption name Hash value 1024
+void UCIHandler::processSetOption(const std::string& command) {
+	std::istringstream iss(command);
+	std::string token, name, value;
+	iss >> token; // setoption
+	while (iss >> token && token != "value") {
+		if (token != "name")
+			name += (name.empty() ? "" : " ") + token;
+	}
+	std::getline(iss >> std::ws, value);
+
+	// مقدار نامعتبر نادیده گرفته می‌شود؛ بازه را خود TT و Search محدود می‌کنند
+	long long number = 0;
+	if (!(std::istringstream(value) >> number))
+		return;
+
+	if (name == "Hash") {
+		if (!ChessEngine::TT.resize(static_cast<size_t>(std::max<long long>(number, 1))))
+			search.output("info string Hash " + std::to_string(number) + " MB unavailable, using "
+				+ std::to_string(ChessEngine::TT.sizeMB()) + " MB");
+	}
+	else if (name == "Threads") {
+		search.setThreads(static_cast<int>(std::clamp<long long>(number, 1, ChessEngine::MaxThreads)));
+	}
+}
@@ -1,54 +1,26 @@
 ﻿#pragma once
-#include "ChessBoard.h"
+#include "../Core/Board.h"
+#include "../search/Search.h"
+#include "../search/TranspositionTable.h"
 #include <string>
 
 class UCIHandler {
 public:
+	UCIHandler();
+	// خواندن دستورات از ورودی استاندارد تا quit
+	void loop();
 	void processCommand(const std::string& command);
 
 private:
-	ChessBoard board;
+	ChessEngine::Board board;
+	// جستجو در تردهای دائمی پس‌زمینه اجرا می‌شود تا stop، ponderhit و isready فوراً پردازش شوند
+	ChessEngine::Search search;
 
+	// توقف جستجوی جاری (در صورت وجود) و انتظار تا چاپ bestmove
+	void stopSearch();
 	void processPosition(const std::string& command);
 	void processGo(const std::string& command);
-	void handleUCICommand(const string& command) {
-		if (command == "uci") {
-			cout << "id name MyEngine\n";
-			cout << "id author YourName\n";
-			cout << "uciok\n";
-		}
-		else if (command.substr(0, 8) == "position") {
-			// پردازش وضعیت تخته
-		}
-		else if (command.substr(0, 2) == "go") {
-			// شروع جستجو
-			Move bestMove = findBestMove(currentBoard, 6);
-			cout << "bestmove " << toChessNotation(bestMove.from) << toChessNotation(bestMove.to) << endl;
-		}
-	}
-
-	void handleUCICommands() {
-		string command;
-		ChessBoard board;
-
-		while (getline(cin, command)) {
-			if (command == "uci") {
-				cout << "id name MyChessEngine\n";
-				cout << "id author YourName\n";
-				cout << "uciok\n";
-			}
-			else if (command.substr(0, 8) == "position") {
-				// پردازش وضعیت (مثلاً position startpos moves e2e4 e7e5)
-			}
-			else if (command.substr(0, 2) == "go") {
-				thread searchThread([&] {
-					Move bestMove = board.findBestMove(6); // عمق ۶
-					cout << "bestmove " << toChessNotation(bestMove.from)
-						<< toChessNotation(bestMove.to) << endl;
-				});
-				searchThread.detach();
-			}
-		}
-	}
-
-};
\ No newline at end of file
+	// گزینه‌های قابل تنظیم موتور (setoption)
+	void printOptions();
+	void processSetOption(const std::string& command);
+};
@@ -0,0 +1,105 @@
+#include "gtest/gtest.h"
+#include "../Bitboards/Bitboards.h"
+#include "../src/search/Perft.h"
+#include "../src/movegen/MoveGenerator.h"
+#include <random>
+#include <sstream>
+
+using namespace ChessEngine;
+
+TEST(BitboardTest, SliderAttacksMatchRayWalk) {
+	// هر دو پشتیبان (جادویی و، در صورت پشتیبانی CPU، PEXT)
+	for (bool allowPext : { false, true }) {
+		initMagics(allowPext);
+		std::mt19937_64 rng(2024);
+		for (int i = 0; i < 100000; ++i) {
+			const Square sq = static_cast<Square>(rng() & 63);
+			const Bitboard occupied = rng() & rng(); // حدود یک‌چهارم خانه‌ها پر
+			ASSERT_EQ(bishopAttacks(sq, occupied), slidingAttacks(PieceType::Bishop, sq, occupied));
+			ASSERT_EQ(rookAttacks(sq, occupied), slidingAttacks(PieceType::Rook, sq, occupied));
+		}
+	}
+}
+
+TEST(BitboardTest, LeaperAndLineTables) {
+	EXPECT_EQ(knightAttacks(A1), squareBB(B3) | squareBB(C2));
+	EXPECT_EQ(kingAttacks(H8), squareBB(G8) | squareBB(G7) | squareBB(H7));
+	EXPECT_EQ(pawnAttacks(E4, Color::White), squareBB(D5) | squareBB(F5));
+	EXPECT_EQ(BetweenBB[A1][D4], squareBB(B2) | squareBB(C3));
+	EXPECT_EQ(BetweenBB[A1][B3], 0ULL);
+	EXPECT_TRUE(aligned(A1, H8, D4));
+}
+
+TEST(PerftTest, StandardSuite) {
+	// عمق ۴ برای اجرای سریع؛ عمق کامل با ابزار perft
+	std::ostringstream out;
+	EXPECT_TRUE(runPerftSuite(4, out)) << out.str();
+}
+
+TEST(PerftTest, ParallelWithSharedHash) {
+	PerftOptions options;
+	options.threads = 4;
+	options.hashMB = 16;
+	std::ostringstream out;
+	EXPECT_TRUE(runPerftSuite(4, out, options)) << out.str();
+}
+
+TEST(MoveGenTest, StagedGenerationMatchesLegalMoves) {
+	// گرفتن‌ها و حرکات آرام افراز حرکات قانونی‌اند و isPseudoLegal
+	// حرکات قانونی موقعیت‌های دیگر را درست رد یا قبول می‌کند
+	MoveList foreign;
+	for (const PerftPosition& pos : PerftSuite) {
+		Board board;
+		board.setFromFEN(pos.fen);
+
+		MoveList all, captures, quiets;
+		MoveGenerator::generateLegalMoves(board, all);
+		MoveGenerator::generateCaptures(board, captures);
+		MoveGenerator::generateQuiets(board, quiets);
+		ASSERT_EQ(all.size(), captures.size() + quiets.size()) << pos.fen;
+
+		for (const Move& m : captures) {
+			EXPECT_TRUE(all.contains(m)) << pos.fen << " " << m.toUCI();
+			EXPECT_TRUE(board.getCapturedPiece(m) != Piece::None || m.isPromotion()) << m.toUCI();
+		}
+		for (const Move& m : quiets) {
+			EXPECT_TRUE(all.contains(m)) << pos.fen << " " << m.toUCI();
+			EXPECT_TRUE(board.getCapturedPiece(m) == Piece::None && !m.isPromotion()) << m.toUCI();
+		}
+
+		for (const Move& m : foreign) {
+			const bool legal = MoveGenerator::isPseudoLegal(board, m) && MoveGenerator::isMoveLegal(board, m);
+			EXPECT_EQ(legal, all.contains(m)) << pos.fen << " " << m.toUCI();
+		}
+		for (const Move& m : all)
+			EXPECT_TRUE(MoveGenerator::isPseudoLegal(board, m)) << pos.fen << " " << m.toUCI();
+
+		foreign.clear();
+		for (const Move& m : all)
+			foreign.push_back(m);
+	}
+}
+
+TEST(MoveGenTest, StaticExchangeEvaluation) {
+	struct SeeCase { const char* fen; Move move; int expected; };
+	const SeeCase cases[] = {
+		// پیاده‌ی دفاع‌نشده
+		{ "1k1r4/1pp4p/p7/4p3/8/P5P1/1PP4P/2K1R3 w - - 0 1", Move(E1, E5), 100 },
+		// دفاع با پیاده: رخ از دست می‌رود
+		{ "4k3/8/3p4/4p3/8/8/8/4R1K1 w - - 0 1", Move(E1, E5), -400 },
+		// رخ دوم از پشت (x-ray) پس گرفتن را بی‌صرفه می‌کند
+		{ "4k3/4r3/8/4p3/8/8/4R3/4R1K1 w - - 0 1", Move(E2, E5), 100 },
+		// پیاده‌ی f6 روی سطر ششم میخ شده و نمی‌تواند پس بگیرد
+		{ "8/8/R4p1k/4p3/8/8/8/4R1K1 w - - 0 1", Move(E1, E5), 100 },
+		// ارتقاء بدون گرفتن
+		{ "4k3/P7/8/8/8/8/8/4K3 w - - 0 1", Move(A7, A8, MoveFlag::Promotion, PieceType::Queen), 800 },
+	};
+
+	for (const SeeCase& c : cases) {
+		Board board;
+		board.setFromFEN(c.fen);
+		EXPECT_EQ(MoveGenerator::see(board, c.move), c.expected) << c.fen;
+		EXPECT_TRUE(MoveGenerator::seeGE(board, c.move, c.expected)) << c.fen;
+		EXPECT_FALSE(MoveGenerator::seeGE(board, c.move, c.expected + 1)) << c.fen;
+	}
+}
@@ -0,0 +1,157 @@
+#include "gtest/gtest.h"
+#include "../src/movegen/MoveGenerator.h"
+
+using namespace ChessEngine;
+
+TEST(BoardTest, FenRoundTrip) {
+	const std::string fen = "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1";
+	Board board;
+	board.setFromFEN(fen);
+	EXPECT_EQ(board.toFEN(), fen);
+	EXPECT_EQ(board.getPiece(E1), Piece::WhiteKing);
+	EXPECT_EQ(board.getCastlingRights(), AllCastling);
+}
+
+TEST(BoardTest, MakeUnmakeRestoresPosition) {
+	// موقعیتی با قلعه، آنپاسان، ارتقاء و گرفتن
+	Board board;
+	board.setFromFEN("r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1");
+	const std::string fen = board.toFEN();
+	const uint64_t key = board.getZobristKey();
+
+	MoveList moves;
+	MoveGenerator::generateLegalMoves(board, moves);
+	ASSERT_EQ(moves.size(), 6u);
+
+	for (const Move& move : moves) {
+		board.makeMove(move);
+
+		// کلید افزایشی باید با کلید محاسبه‌شده از صفر یکی باشد
+		Board fresh;
+		fresh.setFromFEN(board.toFEN());
+		EXPECT_EQ(board.getZobristKey(), fresh.getZobristKey()) << move.toUCI();
+		EXPECT_EQ(board.getPawnKey(), fresh.getPawnKey()) << move.toUCI();
+		EXPECT_EQ(board.getMaterialKey(), fresh.getMaterialKey()) << move.toUCI();
+
+		board.unmakeMove(move);
+		EXPECT_EQ(board.toFEN(), fen) << move.toUCI();
+		EXPECT_EQ(board.getZobristKey(), key) << move.toUCI();
+	}
+}
+
+TEST(BoardTest, EnPassantAndCastlingUpdates) {
+	Board board;
+	board.setFromFEN("r3k2r/8/8/8/3p4/8/4P3/R3K2R w KQkq - 0 1");
+
+	board.makeMove(Move(E2, E4));
+	EXPECT_EQ(board.getEnPassantSquare(), E3);
+
+	board.makeMove(Move(D4, E3, MoveFlag::EnPassant));
+	EXPECT_EQ(board.getPiece(E4), Piece::None);
+	EXPECT_EQ(board.getPiece(E3), Piece::BlackPawn);
+
+	board.makeMove(Move(E1, G1, MoveFlag::Castling));
+	EXPECT_EQ(board.getPiece(F1), Piece::WhiteRook);
+	EXPECT_EQ(board.getCastlingRights(), BlackKingSide | BlackQueenSide);
+
+	board.unmakeMove(Move(E1, G1, MoveFlag::Castling));
+	board.unmakeMove(Move(D4, E3, MoveFlag::EnPassant));
+	board.unmakeMove(Move(E2, E4));
+	EXPECT_EQ(board.toFEN(), "r3k2r/8/8/8/3p4/8/4P3/R3K2R w KQkq - 0 1");
+}
+
+TEST(BoardTest, NullMoveFlipsSideAndClearsEnPassant) {
+	Board board;
+	board.setFromFEN("4k3/8/8/8/3p4/8/4P3/4K3 w - - 0 1");
+	board.makeMove(Move(E2, E4));
+	const std::string fen = board.toFEN();
+	const uint64_t key = board.getZobristKey();
+
+	board.makeNullMove();
+	EXPECT_EQ(board.getTurn(), Color::White);
+	EXPECT_EQ(board.getEnPassantSquare(), NoSquare);
+	EXPECT_EQ(board.getPliesFromNull(), 0);
+
+	Board fresh;
+	fresh.setFromFEN(board.toFEN());
+	EXPECT_EQ(board.getZobristKey(), fresh.getZobristKey());
+
+	board.unmakeNullMove();
+	EXPECT_EQ(board.toFEN(), fen);
+	EXPECT_EQ(board.getZobristKey(), key);
+}
+
+TEST(BoardTest, RepetitionAndUpcomingCycle) {
+	Board board;
+	board.setFromFEN("4k3/8/8/8/8/8/8/R3K2R w - - 0 1");
+	const Move shuffle[4] = { Move(A1, A2), Move(E8, D8), Move(A2, A1), Move(D8, E8) };
+
+	// سه حرکت پس از شروع: سفید با Ra2-a1 موقعیت اولیه را تکرار می‌کند
+	board.makeMove(shuffle[0]);
+	board.makeMove(shuffle[1]);
+	board.makeMove(shuffle[2]);
+	EXPECT_FALSE(board.isDraw(3));
+	EXPECT_TRUE(board.hasGameCycle(4));
+	EXPECT_FALSE(board.hasGameCycle(1)); // پیش از ریشه فقط تکرار دوم حساب می‌شود
+
+	// تکرار درون درخت کافی است، پیش از ریشه نه
+	board.makeMove(shuffle[3]);
+	EXPECT_TRUE(board.isDraw(5));
+	EXPECT_FALSE(board.isDraw(1));
+
+	// بار سوم در تاریخچه‌ی بازی
+	for (const Move& move : shuffle)
+		board.makeMove(move);
+	EXPECT_TRUE(board.isDraw(1));
+}
+
+TEST(BoardTest, FiftyMoveRuleYieldsToCheckmate) {
+	Board board;
+	// حرکت صدم بدون زدن و بدون پیاده: Ra8 مات می‌کند
+	board.setFromFEN("6k1/5ppp/8/8/8/8/8/R5K1 w - - 99 80");
+	board.makeMove(Move(A1, A8));
+	EXPECT_EQ(board.getHalfMoveClock(), 100);
+	EXPECT_FALSE(board.isDraw(1));
+
+	// کیش بدون مات همچنان تساوی است
+	board.setFromFEN("6k1/6pp/8/8/8/8/8/R5K1 w - - 99 80");
+	board.makeMove(Move(A1, A8));
+	EXPECT_TRUE(board.isDraw(1));
+
+	board.setFromFEN("6k1/5ppp/8/8/8/8/8/R5K1 w - - 99 80");
+	board.makeMove(Move(A1, A2));
+	EXPECT_TRUE(board.isDraw(1));
+}
+
+TEST(BoardTest, CompactHistoryBoundsLongGames) {
+	Board board;
+	board.setFromFEN("4k3/8/8/8/8/8/6P1/R3K2R w - - 0 1");
+	const Move shuffle[4] = { Move(A1, A2), Move(E8, D8), Move(A2, A1), Move(D8, E8) };
+
+	// بازی‌ای بسیار بلندتر از پشته‌ی وضعیت، مانند بازپخش position ... moves
+	for (int i = 0; i < 3 * MAX_GAME_PLY; i++) {
+		board.makeMove(shuffle[i % 4]);
+		board.compactHistory();
+	}
+	EXPECT_EQ(board.getGamePly(), 3 * MAX_GAME_PLY);
+	// اینجا تساوی از قانون ۵۰ حرکت است، نه از پیمایش تکرار
+	EXPECT_GE(board.getHalfMoveClock(), 100);
+	EXPECT_TRUE(board.isDraw(1));
+
+	// حرکت برگشت‌ناپذیر و هفت حرکت برگشتی بدون فشرده‌سازی، سپس یک فشرده‌سازی:
+	// پنجره‌ی تکرار باید به ابتدای پشته منتقل شده باشد
+	board.makeMove(Move(G2, G3));
+	const uint64_t key = board.getZobristKey();
+	const Move blackFirst[4] = { Move(E8, D8), Move(A1, A2), Move(D8, E8), Move(A2, A1) };
+	for (int i = 0; i < 7; i++)
+		board.makeMove(blackFirst[i % 4]);
+	board.compactHistory();
+	EXPECT_EQ(board.getHalfMoveClock(), 7);
+	EXPECT_FALSE(board.isDraw(1));
+	EXPECT_TRUE(board.hasGameCycle(1)); // Ra2-a1 بار سوم موقعیت پس از g3 را می‌سازد
+
+	board.makeMove(blackFirst[3]);
+	board.compactHistory();
+	EXPECT_EQ(board.getZobristKey(), key);
+	EXPECT_TRUE(board.isDraw(1));
+}
@@ -1,14 +1,40 @@
 ﻿#include "gtest/gtest.h"  
-#include "../src/Board/Board.h"  
+#include "../src/movegen/MoveGenerator.h"  
+
+using namespace ChessEngine;
 
 TEST(CheckTest, KingInCheck) {
 	Board board;
-	board.set_from_fen("4k3/8/8/8/8/8/4r3/4K3 w - - 0 1");
-	ASSERT_TRUE(board.is_in_check(true)); // شاه سفید در کیش  
+	board.setFromFEN("4k3/8/8/8/8/8/4r3/4K3 w - - 0 1");
+	ASSERT_TRUE(board.isInCheck()); // شاه سفید در کیش  
 }
 
 TEST(CheckmateTest, Foolsmate) {
 	Board board;
-	board.set_from_fen("rnb1kbnr/pppp1ppp/8/4p3/6Pq/5P2/PPPPP2P/RNBQKBNR w KQkq - 0 1");
-	ASSERT_TRUE(board.is_checkmate(true)); // مات در دو حرکت!  
-}
\ No newline at end of file
+	board.setFromFEN("rnb1kbnr/pppp1ppp/8/4p3/6Pq/5P2/PPPPP2P/RNBQKBNR w KQkq - 0 1");
+	MoveList moves;
+	MoveGenerator::generateLegalMoves(board, moves);
+	ASSERT_TRUE(board.isInCheck() && moves.empty()); // مات در دو حرکت!  
+}
+
+TEST(CheckTest, PinnedPieceAndEvasions) {
+	// فیل e2 میخ شده و نمی‌تواند در f1 سد کند؛ فقط شاه حرکت می‌کند
+	Board board;
+	board.setFromFEN("4k3/4r3/8/8/8/8/4B3/3RK2r w - - 0 1");
+	EXPECT_EQ(MoveGenerator::calculatePinned(board, Color::White), squareBB(E2));
+
+	MoveList moves;
+	MoveGenerator::generateLegalMoves(board, moves);
+	EXPECT_EQ(moves.size(), 2u); // Kd2, Kf2
+	for (const Move& move : moves)
+		EXPECT_EQ(move.from(), E1) << move.toUCI();
+}
+
+TEST(CheckTest, EnPassantDiscoveredCheckIsIllegal) {
+	// گرفتن آنپاسان رخ h4 را به شاه a4 باز می‌کند
+	Board board;
+	board.setFromFEN("8/8/8/8/k2pP2R/8/8/4K3 b - e3 0 1");
+	MoveList moves;
+	MoveGenerator::generateLegalMoves(board, moves);
+	EXPECT_FALSE(moves.contains(Move(D4, E3, MoveFlag::EnPassant)));
+}
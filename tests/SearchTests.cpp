@@ -0,0 +1,246 @@
+#include "gtest/gtest.h"
+#include "../src/search/TranspositionTable.h"
+#include "../src/search/Search.h"
+#include "../src/search/History.h"
+#include "../src/search/TimeManager.h"
+#include "../src/movegen/MoveGenerator.h"
+#include "../evaluation/Evaluator.h"
+#include <algorithm>
+#include <sstream>
+
+using namespace ChessEngine;
+
+TEST(TranspositionTableTest, StoreAndProbe) {
+	TranspositionTable tt;
+	tt.resize(1);
+	tt.store(0x123456789ABCDEF0ULL, Move(E2, E4), -250, 17, 9, Bound::Lower);
+
+	TTData data;
+	ASSERT_TRUE(tt.probe(0x123456789ABCDEF0ULL, data));
+	EXPECT_EQ(data.move, Move(E2, E4));
+	EXPECT_EQ(data.score, -250);
+	EXPECT_EQ(data.eval, 17);
+	EXPECT_EQ(data.depth, 9);
+	EXPECT_EQ(data.bound, Bound::Lower);
+
+	// کلیدی با همان سطل ولی بیت‌های بالای متفاوت نباید پیدا شود
+	EXPECT_FALSE(tt.probe(0x923456789ABCDEF0ULL, data));
+}
+
+TEST(TranspositionTableTest, KeepsDeeperEntryAndMove) {
+	TranspositionTable tt;
+	tt.resize(1);
+	const uint64_t key = 0xDEADBEEFCAFEF00DULL;
+	tt.store(key, Move(E7, E8, MoveFlag::Promotion, PieceType::Queen), 40, 0, 12, Bound::Lower);
+	tt.store(key, Move::none(), 10, 0, 2, Bound::Upper); // کم‌عمق‌تر: نادیده گرفته می‌شود
+
+	TTData data;
+	ASSERT_TRUE(tt.probe(key, data));
+	EXPECT_EQ(data.depth, 12);
+	EXPECT_EQ(data.move, Move(E7, E8, MoveFlag::Promotion, PieceType::Queen));
+
+	tt.newSearch();
+	tt.store(key, Move::none(), 10, 0, 2, Bound::Upper); // سن متفاوت: جایگزین می‌شود ولی حرکت حفظ می‌شود
+	ASSERT_TRUE(tt.probe(key, data));
+	EXPECT_EQ(data.depth, 2);
+	EXPECT_EQ(data.move, Move(E7, E8, MoveFlag::Promotion, PieceType::Queen));
+}
+
+TEST(TranspositionTableTest, SizeIsPowerOfTwoBuckets) {
+	TranspositionTable tt;
+	tt.resize(3);
+	EXPECT_EQ(tt.sizeMB(), 3u);
+	EXPECT_EQ(tt.hashfull(), 0);
+}
+
+TEST(TranspositionTableTest, UsableWithoutResize) {
+	TranspositionTable tt;
+	EXPECT_EQ(tt.sizeMB(), TranspositionTable::DefaultSizeMB);
+	tt.prefetch(0x0123456789ABCDEFULL);
+	tt.store(0x0123456789ABCDEFULL, Move(G1, F3), 30, 5, 4, Bound::Exact);
+
+	TTData data;
+	ASSERT_TRUE(tt.probe(0x0123456789ABCDEFULL, data));
+	EXPECT_EQ(data.move, Move(G1, F3));
+}
+
+TEST(HistoryTest, GravityKeepsEntriesBounded) {
+	int16_t entry = 0;
+	for (int i = 0; i < 1000; i++)
+		updateHistory(entry, historyBonus(20));
+	EXPECT_LE(entry, HistoryMax);
+	EXPECT_GT(entry, HistoryMax * 9 / 10);
+
+	// جریمه‌ی پیاپی مقدار را به سمت منفی می‌برد ولی از کف پایین‌تر نمی‌رود
+	for (int i = 0; i < 1000; i++)
+		updateHistory(entry, -historyBonus(20));
+	EXPECT_GE(entry, -HistoryMax);
+	EXPECT_LT(entry, 0);
+}
+
+TEST(TimeManagerTest, BudgetsStayWithinClock) {
+	TimeManager tm;
+	SearchLimits limits;
+	tm.init(limits, Color::White);
+	EXPECT_FALSE(tm.enabled());
+
+	limits.moveTime = 1000;
+	tm.init(limits, Color::White);
+	EXPECT_TRUE(tm.fixedTime());
+	EXPECT_EQ(tm.optimum(), tm.maximum());
+	EXPECT_LE(tm.maximum(), 1000);
+
+	// زمان کم با افزایش زیاد: سقف سخت هرگز از ساعت باقی‌مانده بیشتر نمی‌شود
+	limits = SearchLimits();
+	limits.time[1] = 1000;
+	limits.inc[1] = 2000;
+	tm.init(limits, Color::Black);
+	EXPECT_FALSE(tm.fixedTime());
+	EXPECT_GT(tm.optimum(), 0);
+	EXPECT_LE(tm.optimum(), tm.maximum());
+	EXPECT_LT(tm.maximum(), 1000);
+
+	// ساعت کم بدون افزایش: بودجه متناسب با زمان باقی‌مانده است نه یک میلی‌ثانیه
+	limits = SearchLimits();
+	limits.time[0] = 1500;
+	tm.init(limits, Color::White);
+	EXPECT_GE(tm.optimum(), 1500 / 60);
+	EXPECT_LT(tm.maximum(), 1500);
+	limits.time[0] = 200;
+	tm.init(limits, Color::White);
+	EXPECT_GT(tm.optimum(), 1);
+	EXPECT_GT(tm.maximum(), tm.optimum());
+
+	limits = SearchLimits();
+	limits.time[0] = 60000;
+	limits.movesToGo = 1;
+	tm.init(limits, Color::White);
+	EXPECT_LT(tm.maximum(), 60000);
+	EXPECT_GT(tm.optimum(), 10000);
+
+	// پایداری زمان را کوتاه و تغییر بهترین حرکت یا افت امتیاز آن را بلند می‌کند
+	EXPECT_LT(TimeManager::scale(5, 0, 0), 1.0);
+	EXPECT_GT(TimeManager::scale(0, 2, 0), TimeManager::scale(0, 0, 0));
+	EXPECT_GT(TimeManager::scale(0, 0, 100), TimeManager::scale(0, 0, 0));
+}
+
+TEST(EvaluatorTest, KXKDrivesToMate) {
+	Evaluator evaluator;
+	Board board;
+
+	// رخ در برابر شاه تنها: برد، و شاه ضعیف در گوشه بدتر از مرکز است
+	board.setFromFEN("7k/8/8/8/8/8/8/R3K3 w - - 0 1");
+	const int corner = evaluator.evaluate(board);
+	EXPECT_GT(corner, Evaluator::PieceValues[static_cast<int>(PieceType::Rook)]);
+	board.setFromFEN("8/8/8/4k3/8/8/8/R3K3 w - - 0 1");
+	EXPECT_LT(evaluator.evaluate(board), corner);
+
+	// از دید طرف ضعیف منفی است
+	board.setFromFEN("7k/8/8/8/8/8/8/R3K3 b - - 0 1");
+	EXPECT_EQ(evaluator.evaluate(board), -corner);
+}
+
+TEST(EvaluatorTest, KNNKIsDraw) {
+	Evaluator evaluator;
+	Board board;
+	board.setFromFEN("7k/8/8/8/8/8/8/1N2K1N1 w - - 0 1");
+	EXPECT_EQ(evaluator.evaluate(board), 0);
+	board.setFromFEN("1n2k1n1/8/8/8/8/8/8/7K w - - 0 1");
+	EXPECT_EQ(evaluator.evaluate(board), 0);
+
+	// فیل و اسب مات اجباری دارد
+	board.setFromFEN("7k/8/8/8/8/8/8/1N2KB2 w - - 0 1");
+	EXPECT_GT(evaluator.evaluate(board), Evaluator::PieceValues[static_cast<int>(PieceType::Rook)]);
+
+	// سه اسب، یا دو اسب در برابر شاه و پیاده، بردنی است و نباید تساوی شمرده شود
+	board.setFromFEN("7k/8/8/8/8/8/8/1N2KNN1 w - - 0 1");
+	EXPECT_GT(evaluator.evaluate(board), Evaluator::PieceValues[static_cast<int>(PieceType::Rook)]);
+	board.setFromFEN("7k/8/8/7p/8/8/8/1N2K1N1 w - - 0 1");
+	EXPECT_GT(evaluator.evaluate(board), Evaluator::PieceValues[static_cast<int>(PieceType::Pawn)]);
+}
+
+TEST(SearchTest, FindsMateInOneWithHelperThreads) {
+	Board board;
+	board.setFromFEN("r1bqkb1r/pppp1ppp/2n2n2/4p2Q/2B1P3/8/PPPP1PPP/RNB1K1NR w KQkq - 4 4");
+	TT.resize(1);
+
+	for (int threads : { 1, 4 }) {
+		Search search;
+		search.setThreads(threads);
+		SearchLimits limits;
+		limits.depth = 4;
+		search.start(board, limits);
+		SearchResult result = search.wait();
+
+		EXPECT_EQ(result.bestMove, Move(H5, F7));
+		EXPECT_EQ(result.score, mateIn(1));
+		EXPECT_EQ(result.depth, 4);
+	}
+}
+
+TEST(SearchTest, StopEndsInfiniteSearch) {
+	Board board;
+	TT.resize(1);
+	Search search;
+	search.setThreads(2);
+	SearchLimits limits;
+	limits.infinite = true;
+	search.start(board, limits);
+	search.stop();
+	SearchResult result = search.wait();
+
+	// حتی بدون تکرار کامل یک حرکت قانونی برگردانده می‌شود
+	MoveList moves;
+	MoveGenerator::generateLegalMoves(board, moves);
+	EXPECT_TRUE(moves.contains(result.bestMove));
+}
+
+TEST(SearchTest, ReportsLegalPrincipalVariation) {
+	Board board;
+	board.setFromFEN("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1");
+	TT.resize(1);
+	Search search;
+	std::ostringstream out;
+	search.setOutput(&out);
+	SearchLimits limits;
+	limits.depth = 7;
+	search.start(board, limits);
+	SearchResult result = search.wait();
+
+	// آخرین خط info: PV باید با bestmove شروع شود و همه‌ی حرکاتش قانونی باشند
+	std::string line, lastInfo;
+	std::istringstream lines(out.str());
+	while (std::getline(lines, line))
+		if (line.rfind("info depth", 0) == 0)
+			lastInfo = line;
+	std::istringstream pv(lastInfo.substr(lastInfo.find(" pv ") + 4));
+	std::string token;
+	int length = 0;
+	while (pv >> token) {
+		MoveList moves;
+		MoveGenerator::generateLegalMoves(board, moves);
+		const ScoredMove* it = std::find_if(moves.begin(), moves.end(),
+			[&](const ScoredMove& m) { return m.toUCI() == token; });
+		ASSERT_NE(it, moves.end()) << token << " in " << lastInfo;
+		if (length == 0) {
+			EXPECT_EQ(Move(*it), result.bestMove);
+		}
+		board.makeMove(*it);
+		length++;
+	}
+	EXPECT_GT(length, 1);
+}
+
+TEST(SearchTest, GoPerftRunsInBackground) {
+	Board board;
+	Search search;
+	search.setThreads(2);
+	std::ostringstream out;
+	search.setOutput(&out);
+	SearchLimits limits;
+	limits.perft = 4;
+	search.start(board, limits);
+	EXPECT_EQ(search.wait().nodes, 197281u);
+	EXPECT_NE(out.str().find("Nodes searched: 197281"), std::string::npos);
+	EXPECT_EQ(out.str().find("bestmove"), std::string::npos);
+}